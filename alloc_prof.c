@@ -0,0 +1,139 @@
+#define ALLOC_PROF_IMPL
+#include "shell.h"
+
+alloc_prof_t alloc_prof = {-1, 0, NULL, 0, NULL, NULL, 0, 0, 0, 0, 0, 0};
+
+/**
+ * prof_site - Finds the slot of a call site, adding it if needed.
+ * @file: The source file of the call.
+ * @line: Its line.
+ *
+ * The tag of the outermost tagged helper being run wins over the place
+ * the helper itself calls malloc() from.
+ *
+ * Return: The slot, a shared overflow slot once the table is full.
+ */
+static alloc_site_t *prof_site(const char *file, int line)
+{
+	static alloc_site_t other = {"(other)", 0, 0, 0, 0, 0};
+	size_t h, n;
+	alloc_site_t *s;
+
+	if (alloc_prof.depth)
+		file = alloc_prof.file, line = alloc_prof.line;
+	h = ((size_t)file >> 3) * 31 + (size_t)line * 2654435761UL;
+	for (n = 0; n < PROF_SITES; n++)
+	{
+		s = &alloc_prof.sites[(h + n) & (PROF_SITES - 1)];
+		if (s->file == file && s->line == line)
+			return (s);
+		if (!s->file)
+		{
+			s->file = file, s->line = line;
+			return (s);
+		}
+	}
+	return (&other);
+}
+
+/**
+ * prof_add - Accounts for a new block and skips its header.
+ * @h: The block, NULL if the allocation failed.
+ * @n: The size asked for.
+ * @file: The source file of the call.
+ * @line: Its line.
+ *
+ * Return: The memory for the caller, NULL if @h is NULL.
+ */
+static void *prof_add(alloc_hdr_t *h, size_t n, const char *file, int line)
+{
+	alloc_site_t *s;
+
+	if (!h)
+		return (NULL);
+	s = prof_site(file, line);
+	h->size = n, h->site = s;
+	s->allocs++, s->bytes += n;
+	s->live++, s->live_bytes += n;
+	alloc_prof.allocs++;
+	alloc_prof.bytes += n;
+	alloc_prof.live += n;
+	if (alloc_prof.live > alloc_prof.peak)
+		alloc_prof.peak = alloc_prof.live;
+	if (alloc_prof.live > alloc_prof.top)
+		alloc_prof.top = alloc_prof.live;
+	return (h + 1);
+}
+
+/**
+ * prof_malloc - Allocates memory, profiling it if SHELL_ALLOCPROF is set.
+ * @n: The size.
+ * @file: The source file of the call.
+ * @line: Its line.
+ *
+ * Return: The memory, NULL on failure.
+ */
+void *prof_malloc(size_t n, const char *file, int line)
+{
+	if (!alloc_prof.on || (alloc_prof.on < 0 && !prof_on()))
+		return (malloc(n));
+	if (n > (size_t)-1 - sizeof(alloc_hdr_t))
+		return (NULL);
+	return (prof_add(malloc(sizeof(alloc_hdr_t) + n), n, file, line));
+}
+
+/**
+ * prof_realloc - Resizes memory, profiling it if SHELL_ALLOCPROF is set.
+ * @p: The memory, NULL to allocate it.
+ * @n: The new size.
+ * @file: The source file of the call.
+ * @line: Its line.
+ *
+ * A resized block counts as freed and allocated again at @file:@line.
+ *
+ * Return: The memory, NULL on failure with @p left as it was.
+ */
+void *prof_realloc(void *p, size_t n, const char *file, int line)
+{
+	alloc_hdr_t *h = p ? (alloc_hdr_t *)p - 1 : NULL, *r;
+	alloc_site_t *s;
+	size_t old;
+
+	if (!alloc_prof.on || (alloc_prof.on < 0 && !prof_on()))
+		return (realloc(p, n));
+	if (!p)
+		return (prof_malloc(n, file, line));
+	if (n > (size_t)-1 - sizeof(alloc_hdr_t))
+		return (NULL);
+	old = h->size, s = h->site;
+	r = realloc(h, sizeof(alloc_hdr_t) + n);
+	if (!r)
+		return (NULL);
+	s->live--, s->live_bytes -= old;
+	alloc_prof.live -= old;
+	alloc_prof.frees++;
+	return (prof_add(r, n, file, line));
+}
+
+/**
+ * prof_free - Frees memory, profiling it if SHELL_ALLOCPROF is set.
+ * @p: The memory, may be NULL.
+ *
+ * Return: void.
+ */
+void prof_free(void *p)
+{
+	alloc_hdr_t *h;
+
+	if (alloc_prof.on <= 0 || !p)
+	{
+		free(p);
+		return;
+	}
+	h = (alloc_hdr_t *)p - 1;
+	h->site->live--;
+	h->site->live_bytes -= h->size;
+	alloc_prof.live -= h->size;
+	alloc_prof.frees++;
+	free(h);
+}
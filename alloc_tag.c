@@ -0,0 +1,107 @@
+#include "shell.h"
+
+/**
+ * prof_on - Tells if the allocation profiler runs, starting it if needed.
+ *
+ * The profiler is on when SHELL_ALLOCPROF is set and not "0" at the
+ * first allocation, and stays so: blocks carry a header only then.
+ * Its tables come from calloc(), which it does not track.
+ *
+ * Return: 1 if it runs, 0 otherwise.
+ */
+int prof_on(void)
+{
+	char *s;
+
+	if (alloc_prof.on >= 0)
+		return (alloc_prof.on);
+	s = getenv("SHELL_ALLOCPROF");
+	alloc_prof.on = s && *s && _strcmp(s, "0");
+	if (!alloc_prof.on)
+		return (0);
+	alloc_prof.sites = calloc(PROF_SITES, sizeof(alloc_site_t));
+	alloc_prof.cmds = calloc(PROF_CMDS, sizeof(alloc_cmd_t));
+	if (!alloc_prof.sites || !alloc_prof.cmds)
+		alloc_prof.on = 0;
+	return (alloc_prof.on);
+}
+
+/**
+ * prof_enter - Starts a call of a helper that allocates for its caller.
+ * @file: The source file the helper is called from.
+ * @line: The line it is called from.
+ *
+ * What the helper allocates, through other helpers too, is tagged with
+ * the place of the outermost call rather than with the helper's own
+ * malloc() line, so that "_strdup" reads as its many callers.
+ *
+ * Return: void.
+ */
+void prof_enter(const char *file, int line)
+{
+	if (!alloc_prof.depth++)
+		alloc_prof.file = file, alloc_prof.line = line;
+}
+
+/**
+ * prof_leave - Ends the call of a helper started with prof_enter().
+ * @p: What the helper returned.
+ *
+ * Return: @p.
+ */
+void *prof_leave(void *p)
+{
+	alloc_prof.depth--;
+	return (p);
+}
+
+/**
+ * prof_mark - Notes where the allocation counters stand before a command.
+ * @mark: Three counters to fill, for prof_command().
+ *
+ * Return: void.
+ */
+void prof_mark(unsigned long *mark)
+{
+	mark[0] = alloc_prof.allocs;
+	mark[1] = alloc_prof.bytes;
+	mark[2] = alloc_prof.top = alloc_prof.live;
+}
+
+/**
+ * prof_command - Charges what a command allocated to its name.
+ * @line: The command line, named after its first word.
+ * @mark: What prof_mark() noted before it ran.
+ *
+ * Names beyond PROF_CMDS share the last slot.
+ *
+ * Return: void.
+ */
+void prof_command(char *line, unsigned long *mark)
+{
+	alloc_cmd_t *c;
+	char name[32];
+	int i, n;
+
+	if (alloc_prof.on <= 0 || !line)
+		return;
+	while (*line == ' ' || *line == '\t')
+		line++;
+	for (n = 0; n < 31 && line[n] && !is_delim(line[n], " \t\n;&|<>"); n++)
+		name[n] = line[n];
+	name[n] = 0;
+	if (!n)
+		return;
+	for (i = 0; i < PROF_CMDS - 1; i++)
+		if (!alloc_prof.cmds[i].name[0]
+				|| !_strcmp(alloc_prof.cmds[i].name, name))
+			break;
+	c = &alloc_prof.cmds[i];
+	if (!c->name[0])
+		_strcpy(c->name, i == PROF_CMDS - 1 ? "(other)" : name);
+	c->runs++;
+	c->allocs += alloc_prof.allocs - mark[0];
+	c->bytes += alloc_prof.bytes - mark[1];
+	if (alloc_prof.top - mark[2] > c->peak)
+		c->peak = alloc_prof.top - mark[2];
+}
@@ -0,0 +1,163 @@
+#include "shell.h"
+
+/* 1 while sorting call sites by live bytes rather than by allocations */
+static int by_live;
+
+/**
+ * site_cmp - Orders call sites, the busiest first.
+ * @a: The first site pointer.
+ * @b: The second site pointer.
+ *
+ * Return: Less than, equal to or greater than 0, for qsort().
+ */
+static int site_cmp(const void *a, const void *b)
+{
+	const alloc_site_t *x = *(alloc_site_t * const *)a;
+	const alloc_site_t *y = *(alloc_site_t * const *)b;
+	unsigned long m = by_live ? x->live_bytes : x->allocs;
+	unsigned long n = by_live ? y->live_bytes : y->allocs;
+
+	return (m < n ? 1 : -(m > n));
+}
+
+/**
+ * put_row - Prints a tab separated row of counters and a name.
+ * @fd: 1 for stdout, 2 for stderr.
+ * @v: The counters.
+ * @n: How many there are.
+ * @name: The name ending the row.
+ * @line: A line number to put after the name, 0 for none.
+ *
+ * Return: void.
+ */
+static void put_row(int fd, unsigned long *v, int n, const char *name,
+		int line)
+{
+	void (*put)(char *) = fd == 2 ? _eputs : _puts;
+	int i;
+
+	for (i = 0; i < n; i++)
+	{
+		put(convert_num_to_str(v[i], 10, CONVERT_UNSIGNED));
+		put("\t");
+	}
+	put((char *)name);
+	if (line)
+	{
+		put(":");
+		put(convert_num_to_str(line, 10, 0));
+	}
+	put("\n");
+}
+
+/**
+ * put_sites - Prints the PROF_TOP busiest call sites.
+ * @fd: 1 for stdout, 2 for stderr.
+ * @live: 1 to list the sites still holding memory, by live bytes,
+ *	0 to list them all by number of allocations.
+ *
+ * Return: void.
+ */
+static void put_sites(int fd, int live)
+{
+	alloc_site_t *top[PROF_SITES], *s;
+	unsigned long v[4];
+	int i, n = 0;
+
+	for (i = 0; i < PROF_SITES; i++)
+	{
+		s = &alloc_prof.sites[i];
+		if (s->file && (live ? s->live : s->allocs))
+			top[n++] = s;
+	}
+	by_live = live;
+	qsort(top, n, sizeof(*top), site_cmp);
+	put_row(fd, NULL, 0, live ? "blocks\tbytes\tsite" :
+			"allocs\tbytes\tlive\tlive_bytes\tsite", 0);
+	for (i = 0; i < n && i < PROF_TOP; i++)
+	{
+		s = top[i];
+		v[0] = live ? s->live : s->allocs;
+		v[1] = live ? s->live_bytes : s->bytes;
+		v[2] = s->live, v[3] = s->live_bytes;
+		put_row(fd, v, live ? 2 : 4, s->file, s->line);
+	}
+}
+
+/**
+ * _allocprof - Prints or resets the allocation profile.
+ * @info: Structure containing potential arguments. Used to maintain
+ *        a constant function prototype.
+ *
+ * `allocprof' prints the totals, the PROF_TOP call sites that
+ * allocated the most often, and what the lines run so far allocated by
+ * their first word; peak is the most the live bytes grew during one of
+ * them. `allocprof -r' zeroes the per site and per command counts. It
+ * needs SHELL_ALLOCPROF set when the shell starts.
+ *
+ * Return: 0 on success, 1 if the profiler is off, 2 on a bad option.
+ */
+int _allocprof(param_t *info)
+{
+	unsigned long v[4];
+	alloc_site_t *s;
+	alloc_cmd_t *c;
+	int i;
+
+	if (info->argc > 1 && _strcmp(info->argv[1], "-r"))
+	{
+		_eputs(info->fname);
+		_eputs(": allocprof: usage: allocprof [-r]\n");
+		return (2);
+	}
+	if (alloc_prof.on <= 0)
+	{
+		_eputs(info->fname);
+		_eputs(": allocprof: SHELL_ALLOCPROF is not set\n");
+		return (1);
+	}
+	if (info->argc > 1)
+	{
+		for (s = alloc_prof.sites, i = 0; i < PROF_SITES; i++)
+			s[i].allocs = s[i].bytes = 0;
+		_memset((void *)alloc_prof.cmds, 0,
+				PROF_CMDS * sizeof(alloc_cmd_t));
+		alloc_prof.peak = alloc_prof.live;
+		return (0);
+	}
+	v[0] = alloc_prof.allocs, v[1] = alloc_prof.frees;
+	v[2] = alloc_prof.live, v[3] = alloc_prof.peak;
+	put_row(1, NULL, 0, "allocs\tfrees\tlive_bytes\tpeak_bytes", 0);
+	put_row(1, v, 4, "total", 0);
+	put_sites(1, 0);
+	put_row(1, NULL, 0, "runs\tallocs\tbytes\tpeak_bytes\tcommand", 0);
+	for (i = 0; i < PROF_CMDS && alloc_prof.cmds[i].name[0]; i++)
+	{
+		c = &alloc_prof.cmds[i];
+		v[0] = c->runs, v[1] = c->allocs;
+		v[2] = c->bytes, v[3] = c->peak;
+		put_row(1, v, 4, c->name, 0);
+	}
+	return (0);
+}
+
+/**
+ * prof_leaks - Reports the memory still allocated as the shell exits.
+ *
+ * Prints to stderr the number of blocks not freed and the call sites
+ * holding the most bytes, when the profiler runs and anything leaked.
+ *
+ * Return: void.
+ */
+void prof_leaks(void)
+{
+	unsigned long v[2];
+
+	if (alloc_prof.on <= 0 || alloc_prof.allocs == alloc_prof.frees)
+		return;
+	v[0] = alloc_prof.allocs - alloc_prof.frees, v[1] = alloc_prof.live;
+	_eputs("allocprof: leaked at exit:\n");
+	put_row(2, v, 2, "total", 0);
+	put_sites(2, 1);
+	_eputchar(BUFFER_FLUSH);
+}
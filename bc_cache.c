@@ -0,0 +1,149 @@
+#include "shell.h"
+
+/**
+ * bc_checksum - Computes the FNV-1a hash of the code after the header.
+ * @sb: The bytecode buffer.
+ *
+ * Return: The hash.
+ */
+unsigned long bc_checksum(strbuf_t *sb)
+{
+	unsigned long h = 14695981039346656037UL;
+	size_t i;
+
+	for (i = BC_HEADER_SIZE; i < sb->len; i++)
+		h = (h ^ (unsigned char)sb->s[i]) * 1099511628211UL;
+	return (h);
+}
+
+/**
+ * bc_cache_path - Builds the cache file name of a script.
+ * @info: Pointer to the parameter & return info struct.
+ * @st: The status of the script file.
+ *
+ * Compiled scripts live in $XDG_CACHE_HOME/hsh, or ~/.cache/hsh, named
+ * after the device and inode of the script. The directories are created
+ * when missing.
+ *
+ * Return: The malloc'ed path, or NULL if there is no cache directory.
+ */
+char *bc_cache_path(param_t *info, struct stat *st)
+{
+	char *base = _getenv(info, "XDG_CACHE_HOME="), *num;
+	strbuf_t sb = {NULL, 0, 0};
+
+	if (!base && !_getenv(info, "HOME="))
+		return (NULL);
+	if (base)
+		sb_append(&sb, base, _strlen(base));
+	else
+	{
+		base = _getenv(info, "HOME=");
+		sb_append(&sb, base, _strlen(base));
+		sb_append(&sb, "/.cache", 7);
+	}
+	mkdir(sb.s, 0700);
+	sb_append(&sb, "/" BC_DIR, _strlen(BC_DIR) + 1);
+	mkdir(sb.s, 0700);
+	num = convert_num_to_str(st->st_dev, 16, CONVERT_LC | CONVERT_UNSIGNED);
+	sb_append(&sb, "/", 1);
+	sb_append(&sb, num, _strlen(num));
+	num = convert_num_to_str(st->st_ino, 16, CONVERT_LC | CONVERT_UNSIGNED);
+	sb_append(&sb, "-", 1);
+	sb_append(&sb, num, _strlen(num));
+	return (sb.s);
+}
+
+/**
+ * bc_header - Starts a bytecode buffer with the header for a script.
+ * @sb: The empty bytecode buffer.
+ * @st: The status of the script file.
+ *
+ * The header is the magic, the format version, the device, inode,
+ * mtime and size of the script, then the checksum of the code, left
+ * at 0 until bc_save() fills it in.
+ *
+ * Return: 0 on success, -1 on allocation failure.
+ */
+int bc_header(strbuf_t *sb, struct stat *st)
+{
+	if (sb_append(sb, BC_MAGIC, 4) || bc_put_num(sb, BC_VERSION, 1)
+			|| bc_put_num(sb, st->st_dev, 8)
+			|| bc_put_num(sb, st->st_ino, 8)
+			|| bc_put_num(sb, st->st_mtim.tv_sec, 8)
+			|| bc_put_num(sb, st->st_mtim.tv_nsec, 8)
+			|| bc_put_num(sb, st->st_size, 8)
+			|| bc_put_num(sb, 0, 8))
+		return (-1);
+	return (0);
+}
+
+/**
+ * bc_load - Loads the cached bytecode of a script.
+ * @info: Pointer to the parameter & return info struct.
+ * @st: The status of the script file.
+ * @sb: The empty buffer to load the code into.
+ *
+ * Return: 0 if up to date code was loaded, -1 otherwise.
+ */
+int bc_load(param_t *info, struct stat *st, strbuf_t *sb)
+{
+	strbuf_t want = {NULL, 0, 0};
+	char *path = bc_cache_path(info, st);
+	size_t i, pos = BC_HEADER_SIZE - 8;
+	int fd = path ? open(path, O_RDONLY | O_CLOEXEC) : -1;
+
+	free(path);
+	if (fd == -1)
+		return (-1);
+	while (sb_read_fd(sb, fd) > 0)
+		;
+	close(fd);
+	if (bc_header(&want, st) || sb->len < BC_HEADER_SIZE)
+		return (sb_free(&want), sb_free(sb), -1);
+	for (i = 0; i < pos && sb->s[i] == want.s[i]; i++)
+		;
+	sb_free(&want);
+	if (i < pos || bc_get_num(sb, &pos, 8) != bc_checksum(sb))
+		return (sb_free(sb), -1);
+	return (0);
+}
+
+/**
+ * bc_save - Writes the bytecode of a script to the cache.
+ * @info: Pointer to the parameter & return info struct.
+ * @st: The status of the script file.
+ * @sb: The bytecode, header included; its checksum is filled in.
+ *
+ * The code is written to a temporary file renamed over the old one, so
+ * a concurrent run never reads a half written file.
+ *
+ * Return: 0 on success, -1 on failure.
+ */
+int bc_save(param_t *info, struct stat *st, strbuf_t *sb)
+{
+	char *path = bc_cache_path(info, st), *tmp;
+	unsigned long sum = bc_checksum(sb);
+	size_t len = sb->len, done;
+	ssize_t w = 0;
+	int fd;
+
+	for (done = BC_HEADER_SIZE - 8; done < BC_HEADER_SIZE; done++)
+		sb->s[done] = sum & 0xff, sum >>= 8;
+	tmp = path ? malloc(_strlen(path) + 24) : NULL;
+	if (!tmp)
+		return (free(path), -1);
+	_strcpy(tmp, path);
+	_strcat(tmp, ".");
+	_strcat(tmp, convert_num_to_str(getpid(), 10, 0));
+	fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+	for (done = 0; fd != -1 && done < len && w >= 0; done += w)
+		w = write(fd, sb->s + done, len - done);
+	if (fd != -1)
+		close(fd);
+	if (fd == -1 || w < 0 || rename(tmp, path))
+		unlink(tmp), fd = -1;
+	free(tmp);
+	free(path);
+	return (fd == -1 ? -1 : 0);
+}
@@ -0,0 +1,123 @@
+#include "shell.h"
+
+/**
+ * bc_get_word - Decodes a word of a bytecode buffer.
+ * @sb: The bytecode buffer.
+ * @pos: Address of the read position, moved past the word.
+ *
+ * Return: The malloc'ed word, or NULL on malformed code or allocation
+ *	failure.
+ */
+static char *bc_get_word(strbuf_t *sb, size_t *pos)
+{
+	size_t len = bc_get_num(sb, pos, 4);
+	char *w;
+
+	if (*pos + len > sb->len)
+		return (NULL);
+	w = malloc(len + 1);
+	if (!w)
+		return (NULL);
+	_strncpy(w, sb->s + *pos, len + 1);
+	*pos += len;
+	return (w);
+}
+
+/**
+ * bc_get_redirs - Decodes the redirections of a command.
+ * @sb: The bytecode buffer.
+ * @pos: Address of the read position, moved past the redirections.
+ * @cmd: The command, its redirections are appended to it.
+ * @n: The number of redirections.
+ *
+ * Return: 0 on success, -1 on malformed code or allocation failure.
+ */
+static int bc_get_redirs(strbuf_t *sb, size_t *pos, cmd_t *cmd, int n)
+{
+	redir_t **r = &(cmd->redirs);
+
+	for (; n > 0; n--, r = &((*r)->next))
+	{
+		*r = malloc(sizeof(redir_t));
+		if (!*r)
+			return (-1);
+		(*r)->next = NULL;
+		(*r)->type = bc_get_num(sb, pos, 1);
+		(*r)->fd = bc_get_num(sb, pos, 1);
+		(*r)->word = bc_get_word(sb, pos);
+		if (!(*r)->word)
+			return (-1);
+	}
+	return (0);
+}
+
+/**
+ * bc_get_cmd - Decodes one command of a bytecode buffer.
+ * @sb: The bytecode buffer.
+ * @pos: Address of the read position, just past BC_CMD.
+ *
+ * Return: The command, or NULL on malformed code or allocation failure.
+ */
+static cmd_t *bc_get_cmd(strbuf_t *sb, size_t *pos)
+{
+	cmd_t *cmd = malloc(sizeof(cmd_t));
+	int i, n;
+
+	if (!cmd)
+		return (NULL);
+	cmd->op = bc_get_num(sb, pos, 1);
+	cmd->timed = bc_get_num(sb, pos, 1);
+	cmd->argc = bc_get_num(sb, pos, 2);
+	n = bc_get_num(sb, pos, 2);
+	cmd->redirs = NULL;
+	cmd->next = NULL;
+	cmd->argv = malloc(sizeof(char *) * (cmd->argc + 1));
+	if (!cmd->argv)
+		return (free(cmd), NULL);
+	for (i = 0; i <= cmd->argc; i++)
+		cmd->argv[i] = NULL;
+	for (i = 0; i < cmd->argc; i++)
+	{
+		cmd->argv[i] = bc_get_word(sb, pos);
+		if (!cmd->argv[i])
+			return (free_cmds(cmd), NULL);
+	}
+	if (bc_get_redirs(sb, pos, cmd, n))
+		return (free_cmds(cmd), NULL);
+	return (cmd);
+}
+
+/**
+ * bc_get_line - Decodes the next line of a bytecode buffer.
+ * @sb: The bytecode buffer.
+ * @pos: Address of the read position, moved past the line.
+ * @line: Where to store the line number.
+ *
+ * Return: The commands of the line, or NULL at the end of the code or
+ *	on malformed code, in which case *pos is past the end.
+ */
+cmd_t *bc_get_line(strbuf_t *sb, size_t *pos, unsigned int *line)
+{
+	cmd_t *head = NULL, **tail = &head;
+
+	if (*pos >= sb->len || sb->s[*pos] != BC_LINE)
+	{
+		*pos = sb->len + (*pos < sb->len);
+		return (NULL);
+	}
+	(*pos)++;
+	*line = bc_get_num(sb, pos, 4);
+	while (*pos < sb->len && sb->s[*pos] == BC_CMD)
+	{
+		(*pos)++;
+		*tail = bc_get_cmd(sb, pos);
+		if (!*tail)
+		{
+			*pos = sb->len + 1;
+			free_cmds(head);
+			return (NULL);
+		}
+		tail = &((*tail)->next);
+	}
+	return (head);
+}
@@ -0,0 +1,132 @@
+#include "e2e.h"
+
+/*
+ * End-to-end benchmarks of this shell against the other POSIX shells
+ * installed.
+ *
+ *	gcc -O2 -std=gnu89 -o e2e bench/e2e.c bench/e2e_gen.c \
+ *		bench/e2e_sys.c
+ *	./e2e [-w workload] ./hsh [shell...]
+ *
+ * The workloads of e2e_gen.c are written to a scratch directory, which
+ * is also the HOME and working directory of the shells, so that their
+ * history and script caches start out the same each time. Each shell
+ * runs each workload once to warm up, then E2E_PASSES times; the
+ * fastest pass gives the wall time and commands per second, the peak
+ * RSS is the largest of the shell's over all runs. Without shells
+ * named after this one, /bin/sh, dash, bash, ksh, mksh and zsh are
+ * used when installed. One JSON object is printed per workload and
+ * shell.
+ */
+
+/**
+ * run_once - Runs a shell on a script and waits for it.
+ * @shell: The shell.
+ * @w: The workload.
+ * @script: Its script.
+ * @env: The environment of the shell.
+ * @home: Its working directory.
+ * @r: The result to add the wall time, RSS and status of the run to.
+ *
+ * The output of the shell goes to /dev/null.
+ *
+ * Return: 0 on success, -1 if the shell could not be run.
+ */
+static int run_once(char *shell, workload_t *w, char *script, char **env,
+		char *home, result_t *r)
+{
+	struct timespec t0, t1;
+	struct rusage ru;
+	int status;
+	pid_t pid;
+
+	clock_gettime(CLOCK_MONOTONIC, &t0);
+	pid = spawn(shell, w, script, env, home, -1);
+	if (pid == -1 || wait4(pid, &status, 0, &ru) == -1)
+		return (-1);
+	clock_gettime(CLOCK_MONOTONIC, &t1);
+	r->ns += (t1.tv_sec - t0.tv_sec) * 1000000000L
+		+ (t1.tv_nsec - t0.tv_nsec);
+	if (ru.ru_maxrss > r->maxrss)
+		r->maxrss = ru.ru_maxrss;
+	if (!WIFEXITED(status) || WEXITSTATUS(status))
+		r->status = WIFEXITED(status) ? WEXITSTATUS(status)
+			: 128 + WTERMSIG(status);
+	return (0);
+}
+
+/**
+ * run_workload - Runs a workload on each shell and prints the results.
+ * @w: The workload.
+ * @shells: The shells.
+ * @dir: The scratch directory.
+ * @first: 1 until a result was printed.
+ *
+ * Return: 0 on success, -1 if the workload could not be set up.
+ */
+static int run_workload(workload_t *w, char **shells, char *dir, int *first)
+{
+	char *script = gen_script(w, dir), **env = gen_env(w, dir), *hist, *sh;
+	long cmds = w->cmds * w->cycles * w->runs, best;
+	result_t r = {0, 0, 0};
+	int i, p, k;
+	size_t len;
+
+	hist = gen_history(w, &len);
+	for (i = 0; script && env && shells[i]; i++, *first = 0)
+	{
+		sh = shells[i], r.maxrss = 0, r.status = 0, best = -1;
+		for (p = 0; p <= E2E_PASSES; p++)
+		{
+			for (r.ns = 0, k = 0; k < w->runs; k++)
+				if (put_history(dir, hist, len) || run_once(sh,
+						w, script, env, dir, &r))
+					r.status = -1;
+			if (p && (best == -1 || r.ns < best))
+				best = r.ns;
+		}
+		printf("%s\n  {\"workload\": \"%s\", \"shell\": \"%s\", ",
+				*first ? "" : ",", w->name, sh);
+		printf("\"commands\": %ld, \"wall_s\": %.3f, ", cmds,
+				best / 1e9);
+		printf("\"commands_per_s\": %.0f, \"peak_rss_kb\": %ld, ",
+				best > 0 ? cmds * 1e9 / best : 0.0, r.maxrss);
+		printf("\"status\": %d}", r.status);
+		fflush(stdout);
+	}
+	i = script && env ? 0 : -1;
+	free(script), free_env(env), free(hist);
+	return (i);
+}
+
+/**
+ * main - Runs the end-to-end benchmarks and prints the results as JSON.
+ * @ac: The argument count.
+ * @av: The arguments: [-w workload] shell [shell...].
+ *
+ * Return: 0 on success, 1 on failure.
+ */
+int main(int ac, char **av)
+{
+	char *shells[E2E_SHELLS], *only = NULL, *name = av[0];
+	char dir[] = "/tmp/hsh-e2e-XXXXXX";
+	int i, first = 1, ret = 0;
+
+	if (ac > 2 && !strcmp(av[1], "-w"))
+		only = av[2], ac -= 2, av += 2;
+	if (ac < 2)
+	{
+		fprintf(stderr, "usage: %s [-w workload] hsh [shell...]\n",
+				name);
+		return (1);
+	}
+	if (!find_shells(shells, ac - 1, av + 1) || !mkdtemp(dir))
+		return (perror(av[1]), 1);
+	printf("{\"benchmarks\": [");
+	for (i = 0; workloads[i].name; i++)
+		if (!only || !strcmp(only, workloads[i].name))
+			ret |= run_workload(&workloads[i], shells, dir, &first);
+	printf("\n]}\n");
+	rm_tree(dir);
+	return (ret ? 1 : 0);
+}
@@ -0,0 +1,80 @@
+#ifndef _E2E_H_
+#define _E2E_H_
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <string.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <time.h>
+#include <ftw.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+
+/* timed passes of each workload and shell, the fastest one is kept */
+#define E2E_PASSES	3
+
+/* the most shells compared at once */
+#define E2E_SHELLS	16
+
+/* the starts of each shell timed by the startup benchmark, per case */
+#define STARTUP_RUNS	200
+
+/**
+ * struct workload - a script run against each shell
+ * @name: its name, as printed in the JSON
+ * @lines: the lines of the script, repeated @cycles times
+ * @cmds: the simple commands one repetition of @lines runs
+ * @cycles: how many times @lines are repeated
+ * @runs: how many times the shell is started on the script in a pass
+ * @nenv: the number of variables V0 to Vn-1 added to the environment
+ * @nhist: the number of lines in the history file, 0 for none
+ * @piped: 1 to give the script on standard input rather than by name
+ */
+typedef struct workload
+{
+	char *name;
+	char **lines;
+	long cmds;
+	long cycles;
+	int runs;
+	int nenv;
+	int nhist;
+	int piped;
+} workload_t;
+
+/**
+ * struct result - what the passes of a workload on a shell measured
+ * @ns: the wall clock time of the fastest pass, in nanoseconds
+ * @maxrss: the peak RSS of the shell over all passes, in KiB
+ * @status: the exit status of the last run that failed, 0 if none did
+ */
+typedef struct result
+{
+	long ns;
+	long maxrss;
+	int status;
+} result_t;
+
+extern workload_t workloads[];
+extern workload_t startups[];
+
+/* e2e_gen.c */
+char *gen_script(workload_t *, char *);
+char *gen_history(workload_t *, size_t *);
+int put_history(char *, char *, size_t);
+char **gen_env(workload_t *, char *);
+void free_env(char **);
+
+/* e2e_sys.c */
+int find_shells(char **, int, char **);
+void rm_tree(char *);
+pid_t spawn(char *, workload_t *, char *, char **, char *, int);
+
+#endif
@@ -0,0 +1,163 @@
+#include "e2e.h"
+
+static char *builtin_lines[] = {"echo abc def ghi", "test abc = abc", "cd .",
+	NULL};
+static char *true_lines[] = {"/bin/true", NULL};
+static char *chain_lines[] = {
+	"test a = a && echo yes || echo no; test a = b || echo c && echo d",
+	"echo a; echo b; echo c; echo d", NULL};
+static char *var_lines[] = {
+	"echo $HOME $PATH $LOGNAME $SHELL $E_VAR $? $$ $PWD", NULL};
+static char *startup_lines[] = {"echo started", NULL};
+static char *env_lines[] = {"echo $V9999", "/bin/true", NULL};
+
+workload_t workloads[] = {
+	{"builtins_1m", builtin_lines, 3, 333334, 1, 0, 0, 0},
+	{"true_10k", true_lines, 1, 10000, 1, 0, 0, 0},
+	{"chain", chain_lines, 9, 50000, 1, 0, 0, 0},
+	{"vars", var_lines, 1, 200000, 1, 0, 0, 0},
+	{"startup_hist_20k", startup_lines, 1, 1, 10, 0, 20000, 0},
+	{"env_10k", env_lines, 2, 1000, 1, 10000, 0, 0},
+	{NULL, NULL, 0, 0, 0, 0, 0, 0}
+};
+
+workload_t startups[] = {
+	{"bare", startup_lines, 1, 1, STARTUP_RUNS, 0, 0, 0},
+	{"env_10k", startup_lines, 1, 1, STARTUP_RUNS, 10000, 0, 0},
+	{"hist_20k", startup_lines, 1, 1, STARTUP_RUNS, 0, 20000, 0},
+	{"hist_20k_stdin", startup_lines, 1, 1, STARTUP_RUNS, 0, 20000, 1},
+	{"env_10k_hist_20k", startup_lines, 1, 1, STARTUP_RUNS, 10000,
+		20000, 0},
+	{NULL, NULL, 0, 0, 0, 0, 0, 0}
+};
+
+/**
+ * gen_script - Writes the script of a workload.
+ * @w: The workload.
+ * @dir: The directory to write it in.
+ *
+ * Return: The malloc'ed path of the script, NULL on failure.
+ */
+char *gen_script(workload_t *w, char *dir)
+{
+	char *path = malloc(strlen(dir) + strlen(w->name) + 5);
+	FILE *f;
+	long i;
+	int j;
+
+	if (!path)
+		return (NULL);
+	sprintf(path, "%s/%s.sh", dir, w->name);
+	f = fopen(path, "w");
+	if (!f)
+		return (free(path), NULL);
+	for (i = 0; i < w->cycles; i++)
+		for (j = 0; w->lines[j]; j++)
+			fprintf(f, "%s\n", w->lines[j]);
+	if (fclose(f))
+		return (free(path), NULL);
+	return (path);
+}
+
+/**
+ * gen_history - Builds the history file of a workload.
+ * @w: The workload.
+ * @len: Where to store the size of the file.
+ *
+ * Return: The malloc'ed contents, NULL if there is no history.
+ */
+char *gen_history(workload_t *w, size_t *len)
+{
+	char *buf;
+	int i;
+
+	*len = 0;
+	if (!w->nhist)
+		return (NULL);
+	buf = malloc((size_t)w->nhist * 48);
+	if (!buf)
+		return (NULL);
+	for (i = 0; i < w->nhist; i++)
+		*len += sprintf(buf + *len, "echo history line %d | grep %d\n",
+				i, i % 97);
+	return (buf);
+}
+
+/**
+ * put_history - Writes the history file the shells start with.
+ * @home: The HOME of the shells.
+ * @buf: The contents, see gen_history(), NULL to remove the file.
+ * @len: Their size.
+ *
+ * The offset index this shell keeps beside the file is removed, as it
+ * no longer matches.
+ *
+ * Return: 0 on success, -1 on failure.
+ */
+int put_history(char *home, char *buf, size_t len)
+{
+	char path[4096];
+	int fd;
+	ssize_t r = 0;
+
+	snprintf(path, sizeof(path), "%s/.shell_history.idx", home);
+	if (unlink(path) && errno != ENOENT)
+		return (-1);
+	path[strlen(path) - 4] = 0;
+	if (!buf)
+		return (unlink(path) && errno != ENOENT ? -1 : 0);
+	fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (fd == -1)
+		return (-1);
+	r = write(fd, buf, len);
+	close(fd);
+	return ((size_t)r == len ? 0 : -1);
+}
+
+/**
+ * gen_env - Builds the environment of the shells for a workload.
+ * @w: The workload.
+ * @home: Their HOME and working directory.
+ *
+ * Return: The malloc'ed environment, NULL on failure.
+ */
+char **gen_env(workload_t *w, char *home)
+{
+	char **env = calloc(w->nenv + 8, sizeof(char *)), buf[4200];
+	int i, n = 0;
+
+	if (!env)
+		return (NULL);
+	env[n++] = strdup("PATH=/usr/local/bin:/usr/bin:/bin");
+	env[n++] = strdup("LOGNAME=bench");
+	env[n++] = strdup("SHELL=/bin/sh");
+	env[n++] = strdup("E_VAR=some value");
+	snprintf(buf, sizeof(buf), "HOME=%s", home);
+	env[n++] = strdup(buf);
+	snprintf(buf, sizeof(buf), "PWD=%s", home);
+	env[n++] = strdup(buf);
+	for (i = 0; i < w->nenv; i++)
+	{
+		snprintf(buf, sizeof(buf), "V%d=value of variable %d", i, i);
+		env[n++] = strdup(buf);
+	}
+	for (i = 0; i < n; i++)
+		if (!env[i])
+			return (free_env(env), NULL);
+	return (env);
+}
+
+/**
+ * free_env - Frees an environment built by gen_env().
+ * @env: The environment, may be NULL.
+ *
+ * Return: void.
+ */
+void free_env(char **env)
+{
+	char **e;
+
+	for (e = env; e && *e; e++)
+		free(*e);
+	free(env);
+}
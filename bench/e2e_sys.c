@@ -0,0 +1,99 @@
+#include "e2e.h"
+
+/**
+ * rm_entry - Removes a file of the scratch directory, for nftw().
+ * @path: The file.
+ * @st: Unused.
+ * @flag: Unused.
+ * @ftw: Unused.
+ *
+ * Return: 0, so that the walk goes on.
+ */
+static int rm_entry(const char *path, const struct stat *st, int flag,
+		struct FTW *ftw)
+{
+	(void)st, (void)flag, (void)ftw;
+	remove(path);
+	return (0);
+}
+
+/**
+ * rm_tree - Removes the scratch directory and everything in it.
+ * @dir: The directory.
+ *
+ * Return: void.
+ */
+void rm_tree(char *dir)
+{
+	nftw(dir, rm_entry, 16, FTW_DEPTH | FTW_PHYS);
+}
+
+/**
+ * find_shells - Lists the shells to compare.
+ * @shells: Where to put them, E2E_SHELLS slots.
+ * @ac: The argument count, past the options.
+ * @av: The arguments, this shell then maybe others.
+ *
+ * Paths that lead to a shell already listed, such as /bin/sh when it
+ * is dash, are left out.
+ *
+ * Return: The number of shells, 0 if this one cannot be found.
+ */
+int find_shells(char **shells, int ac, char **av)
+{
+	char *known[] = {"/bin/sh", "/bin/dash", "/bin/bash", "/bin/ksh",
+		"/bin/mksh", "/bin/zsh", NULL};
+	struct stat st[E2E_SHELLS];
+	char **from = ac > 1 ? av : known;
+	int i, j, n = 0;
+
+	if (stat(av[0], &st[0]))
+		return (0);
+	shells[n++] = av[0];
+	for (i = ac > 1; from[i] && n < E2E_SHELLS - 1; i++)
+	{
+		if (stat(from[i], &st[n]) || access(from[i], X_OK))
+			continue;
+		for (j = 0; j < n; j++)
+			if (st[j].st_dev == st[n].st_dev
+					&& st[j].st_ino == st[n].st_ino)
+				break;
+		if (j == n)
+			shells[n++] = from[i];
+	}
+	shells[n] = NULL;
+	return (n);
+}
+
+/**
+ * spawn - Starts a shell on the script of a workload.
+ * @shell: The shell.
+ * @w: The workload, which says how the script is given.
+ * @script: The script.
+ * @env: The environment of the shell.
+ * @home: Its working directory.
+ * @out: The fd its output goes to, -1 for /dev/null.
+ *
+ * Errors go to /dev/null.
+ *
+ * Return: The pid of the shell, -1 on failure.
+ */
+pid_t spawn(char *shell, workload_t *w, char *script, char **env,
+		char *home, int out)
+{
+	char *av[3];
+	int fd, in;
+	pid_t pid = fork();
+
+	if (pid)
+		return (pid);
+	av[0] = shell, av[1] = w->piped ? NULL : script, av[2] = NULL;
+	fd = open("/dev/null", O_RDWR);
+	in = w->piped ? open(script, O_RDONLY) : fd;
+	if (fd == -1 || in == -1 || chdir(home) || dup2(in, 0) == -1
+			|| dup2(out == -1 ? fd : out, 1) == -1
+			|| dup2(fd, 2) == -1)
+		_exit(126);
+	execve(shell, av, env);
+	_exit(127);
+}
@@ -0,0 +1,188 @@
+#include "micro.h"
+
+/*
+ * Microbenchmarks of the shell's string, list and I/O routines.
+ *
+ * Build from the top of the tree, with every file of the shell but
+ * main.c:
+ *
+ *	gcc -O2 -std=gnu89 -o micro bench/micro.c bench/micro_str.c \
+ *		bench/micro_list.c bench/micro_io.c bench/micro_env.c \
+ *		$(ls *.c | grep -v '^main.c$')
+ *
+ * `./micro [filter]' runs the cases whose name holds the filter and
+ * prints one JSON object per case: the operations timed, ns_per_op,
+ * and bytes_per_op and allocs_per_op, what one operation allocated.
+ * Cases that stream data also get mb_per_s. Each case is first run
+ * with more and more operations until it takes BENCH_MIN_NS, then
+ * again in another process under the SHELL_ALLOCPROF allocation
+ * profiler to count its allocations, so that the profiler does not
+ * weigh on the timing.
+ */
+static bench_case_t cases[] = {
+	{"strtok/short", bench_strtok, 4},
+	{"strtok/long", bench_strtok, 256},
+	{"strtok2/short", bench_strtok2, 4},
+	{"strtok2/long", bench_strtok2, 256},
+	{"is_delim", bench_is_delim, 0},
+	{"getline/short", bench_getline, 16},
+	{"getline/long", bench_getline, 2000},
+	{"find_path/4", bench_find_path, 4},
+	{"find_path/32", bench_find_path, 32},
+	{"add_node_end/100", bench_add_node_end, 100},
+	{"add_node_end/1000", bench_add_node_end, 1000},
+	{"add_node_end/10000", bench_add_node_end, 10000},
+	{"add_node_end/100000", bench_add_node_end, 100000},
+	{"node_starts_with/100", bench_starts_with, 100},
+	{"node_starts_with/1000", bench_starts_with, 1000},
+	{"node_starts_with/10000", bench_starts_with, 10000},
+	{"node_starts_with/100000", bench_starts_with, 100000},
+	{"list_to_strings/100", bench_to_strings, 100},
+	{"list_to_strings/1000", bench_to_strings, 1000},
+	{"getenv/10", bench_getenv, 10},
+	{"getenv/500", bench_getenv, 500},
+	{"getenv/10000", bench_getenv, 10000},
+	{"setenv_environ/500", bench_setenv, 500},
+	{"hist_add/1000", bench_hist_add, 1000},
+	{"hist_add/100000", bench_hist_add, 100000},
+	{"putchar", bench_putchar, 0},
+	{"puts/64", bench_puts, 64},
+	{NULL, NULL, 0}
+};
+
+/**
+ * bench_start - Starts measuring, once a case is set up.
+ * @b: The case.
+ *
+ * Return: void.
+ */
+void bench_start(bench_t *b)
+{
+	b->a0 = alloc_prof.allocs;
+	b->b0 = alloc_prof.bytes;
+	clock_gettime(CLOCK_MONOTONIC, &b->t0);
+}
+
+/**
+ * bench_stop - Stops measuring, before a case cleans up.
+ * @b: The case.
+ *
+ * Return: void.
+ */
+void bench_stop(bench_t *b)
+{
+	struct timespec t;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	b->ns = (t.tv_sec - b->t0.tv_sec) * 1000000000L
+		+ (t.tv_nsec - b->t0.tv_nsec);
+	b->allocs = alloc_prof.allocs - b->a0;
+	b->alloc_bytes = alloc_prof.bytes - b->b0;
+}
+
+/**
+ * run_pass - Runs a case in a child process and sends back the result.
+ * @b: The case, with the number of operations found by the timing pass
+ *	when @alloc is set.
+ * @alloc: 0 to time the case, 1 to count its allocations.
+ * @fd: The pipe to write the result to.
+ *
+ * Return: Does not return.
+ */
+static void run_pass(bench_t *b, int alloc, int fd)
+{
+	double grow;
+
+	if (alloc)
+	{
+		setenv("SHELL_ALLOCPROF", "1", 1);
+		b->n = b->n < BENCH_ALLOC_OPS ? b->n : BENCH_ALLOC_OPS;
+	}
+	else
+		alloc_prof.on = 0, b->n = 1;
+	while (1)
+	{
+		b->fn(b);
+		if (alloc || b->ns >= BENCH_MIN_NS)
+			break;
+		grow = b->ns > 0 ? 1.2 * BENCH_MIN_NS / b->ns : 100;
+		b->n *= grow > 100 ? 100 : grow < 2 ? 2 : grow;
+	}
+	if (write(fd, b, sizeof(*b)) != sizeof(*b))
+		_exit(1);
+	_exit(0);
+}
+
+/**
+ * run_case - Times a case, counts its allocations and prints the result.
+ * @c: The case.
+ * @first: 1 for the first case printed, 0 to put a comma before it.
+ *
+ * The shell's allocator never runs in this process, so the profiler
+ * is still undecided in the children and each can pick its own state.
+ *
+ * Return: 0 on success, -1 if the case could not be run.
+ */
+static int run_case(bench_case_t *c, int first)
+{
+	bench_t b, r[2];
+	int fds[2], i, status;
+	pid_t pid;
+
+	_memset((void *)&b, 0, sizeof(b));
+	b.name = c->name, b.fn = c->fn, b.arg = c->arg;
+	for (i = 0; i < 2; i++)
+	{
+		if (pipe(fds))
+			return (-1);
+		fflush(stdout);
+		pid = fork();
+		if (pid == 0)
+			close(fds[0]), run_pass(i ? &r[0] : &b, i, fds[1]);
+		close(fds[1]);
+		if (pid == -1 || read(fds[0], &r[i], sizeof(b)) != sizeof(b))
+			return (close(fds[0]), -1);
+		close(fds[0]);
+		waitpid(pid, &status, 0);
+	}
+	printf("%s\n  {\"name\": \"%s\", \"arg\": %ld, \"iterations\": %ld, ",
+			first ? "" : ",", b.name, b.arg, r[0].n);
+	printf("\"ns_per_op\": %.2f, \"bytes_per_op\": %.1f, ",
+			(double)r[0].ns / r[0].n,
+			(double)r[1].alloc_bytes / r[1].n);
+	printf("\"allocs_per_op\": %.2f", (double)r[1].allocs / r[1].n);
+	if (r[0].bytes)
+		printf(", \"mb_per_s\": %.1f",
+				r[0].bytes * 1000.0 * r[0].n / r[0].ns);
+	printf("}");
+	return (0);
+}
+
+/**
+ * main - Runs the benchmark cases and prints their results as JSON.
+ * @ac: The argument count.
+ * @av: The arguments, av[1] may hold a filter on the case names.
+ *
+ * Return: 0 on success, 1 if a case could not be run.
+ */
+int main(int ac, char **av)
+{
+	int i, n = 0, ret = 0;
+
+	printf("{\"benchmarks\": [");
+	for (i = 0; cases[i].name; i++)
+	{
+		if (ac > 1 && !strstr(cases[i].name, av[1]))
+			continue;
+		if (run_case(&cases[i], !n))
+		{
+			fprintf(stderr, "%s: %s: cannot run\n", av[0],
+					cases[i].name);
+			ret = 1;
+			continue;
+		}
+		n++;
+	}
+	printf("\n]}\n");
+	return (ret);
+}
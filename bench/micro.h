@@ -0,0 +1,79 @@
+#ifndef _MICRO_H_
+#define _MICRO_H_
+
+#include "../shell.h"
+
+/* the least time a case is run for to time it, in nanoseconds */
+#define BENCH_MIN_NS	200000000L
+
+/* the most operations a case runs while its allocations are counted */
+#define BENCH_ALLOC_OPS	10000L
+
+/**
+ * struct bench - a benchmark case and what one run of it measured
+ * @name: the case name, as printed in the JSON
+ * @fn: runs @n operations, between bench_start() and bench_stop()
+ * @arg: a size the case is run with, such as a list length
+ * @n: the number of operations to run
+ * @bytes: the bytes of data one operation handles, 0 if that means nothing
+ * @ns: the nanoseconds the operations took
+ * @allocs: the allocations they made
+ * @alloc_bytes: the bytes those asked for
+ * @t0: when bench_start() was called
+ * @a0: the allocation count then
+ * @b0: the allocated bytes then
+ */
+typedef struct bench
+{
+	char *name;
+	void (*fn)(struct bench *);
+	long arg;
+	long n;
+	long bytes;
+	long ns;
+	unsigned long allocs;
+	unsigned long alloc_bytes;
+	struct timespec t0;
+	unsigned long a0;
+	unsigned long b0;
+} bench_t;
+
+/**
+ * struct bench_case - a benchmark case to run
+ * @name: its name
+ * @fn: the function running it
+ * @arg: the size it is run with
+ */
+typedef struct bench_case
+{
+	char *name;
+	void (*fn)(bench_t *);
+	long arg;
+} bench_case_t;
+
+/* micro.c */
+void bench_start(bench_t *);
+void bench_stop(bench_t *);
+
+/* micro_str.c */
+void bench_strtok(bench_t *);
+void bench_strtok2(bench_t *);
+void bench_is_delim(bench_t *);
+
+/* micro_list.c */
+void bench_add_node_end(bench_t *);
+void bench_starts_with(bench_t *);
+void bench_to_strings(bench_t *);
+void bench_hist_add(bench_t *);
+
+/* micro_env.c */
+void bench_getenv(bench_t *);
+void bench_setenv(bench_t *);
+
+/* micro_io.c */
+void bench_getline(bench_t *);
+void bench_find_path(bench_t *);
+void bench_putchar(bench_t *);
+void bench_puts(bench_t *);
+
+#endif
@@ -0,0 +1,79 @@
+#include "micro.h"
+
+static volatile long sink;
+
+/**
+ * make_env - Fills the environment of a shell with variables.
+ * @info: The shell.
+ * @n: How many, "VAR0=value" to "VARn-1=value".
+ *
+ * Return: 0 on success, -1 on allocation failure.
+ */
+static int make_env(param_t *info, long n)
+{
+	char s[64];
+	long i;
+
+	info->env = malloc(sizeof(env_map_t));
+	if (!info->env)
+		return (-1);
+	_memset((void *)info->env, 0, sizeof(env_map_t));
+	for (i = 0; i < n; i++)
+	{
+		_strcpy(s, "VAR");
+		_strcat(s, convert_num_to_str(i, 10, 0));
+		_strcat(s, "=value");
+		if (env_put(info->env, _strdup(s)))
+			return (-1);
+	}
+	return (0);
+}
+
+/**
+ * bench_getenv - Looks up PATH, set last, with _getenv(), as find_cmd()
+ *	does for each command.
+ * @b: The case, the environment holds @arg other variables.
+ *
+ * Return: void.
+ */
+void bench_getenv(bench_t *b)
+{
+	param_t info[] = { PARAM_INIT };
+	long i;
+
+	if (!make_env(info, b->arg) && !_setenv(info, "PATH", "/bin"))
+	{
+		bench_start(b);
+		for (i = 0; i < b->n; i++)
+			sink += _getenv(info, "PATH=") != NULL;
+		bench_stop(b);
+	}
+	env_free(info->env);
+}
+
+/**
+ * bench_setenv - Sets a variable with _setenv() and builds the array
+ *	execve() gets with get_environ(), as a command run after an
+ *	assignment does.
+ * @b: The case, the environment holds @arg variables.
+ *
+ * Return: void.
+ */
+void bench_setenv(bench_t *b)
+{
+	param_t info[] = { PARAM_INIT };
+	long i;
+
+	if (!make_env(info, b->arg))
+	{
+		bench_start(b);
+		for (i = 0; i < b->n; i++)
+		{
+			_setenv(info, "VAR0", "other");
+			sink += get_environ(info) != NULL;
+		}
+		bench_stop(b);
+	}
+	free(info->environ);
+	env_free(info->env);
+}
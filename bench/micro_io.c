@@ -0,0 +1,141 @@
+#include "micro.h"
+
+static volatile long sink;
+
+/**
+ * bench_getline - Reads lines from a pipe with _getline().
+ * @b: The case, lines of @arg bytes and a newline.
+ *
+ * Lines are written to the pipe in batches the pipe can hold and read
+ * back one at a time, so the reads never block.
+ *
+ * Return: void.
+ */
+void bench_getline(bench_t *b)
+{
+	param_t info[] = { PARAM_INIT };
+	char chunk[32 * 1024], *p;
+	long i, j, per = sizeof(chunk) / (b->arg + 1);
+	size_t len;
+	int fds[2];
+
+	if (pipe(fds))
+		return;
+	for (i = 0; i < per * (b->arg + 1); i++)
+		chunk[i] = i % (b->arg + 1) == b->arg ? '\n' : 'x';
+	info->readfd = fds[0];
+	b->bytes = b->arg + 1;
+	bench_start(b);
+	for (i = 0; i < b->n; i += per)
+	{
+		if (write(fds[1], chunk, per * (b->arg + 1)) < 0)
+			break;
+		for (j = 0; j < per; j++)
+		{
+			p = NULL;
+			sink += _getline(info, &p, &len);
+			free(p);
+		}
+	}
+	bench_stop(b);
+	b->n = i;
+	close(fds[0]);
+	close(fds[1]);
+}
+
+/**
+ * bench_find_path - Looks a command up in a PATH with find_path().
+ * @b: The case, @arg directories that do not exist before /bin.
+ *
+ * Return: void.
+ */
+void bench_find_path(bench_t *b)
+{
+	param_t info[] = { PARAM_INIT };
+	char path[64 * 1024];
+	long i;
+
+	path[0] = '\0';
+	for (i = 0; i < b->arg && i < 1024; i++)
+	{
+		_strcat(path, "/nonexistent/");
+		_strcat(path, convert_num_to_str(i, 10, 0));
+		_strcat(path, ":");
+	}
+	_strcat(path, "/bin");
+	bench_start(b);
+	for (i = 0; i < b->n; i++)
+		sink += find_path(info, path, "sh") != NULL;
+	bench_stop(b);
+}
+
+/**
+ * to_null - Points stdout at /dev/null, or back where it was.
+ * @saved: The saved stdout, -1 to save it and point it at /dev/null.
+ *
+ * Return: The saved stdout to pass back in, -2 on failure or once
+ *	stdout is back.
+ */
+static int to_null(int saved)
+{
+	int fd;
+
+	if (saved != -1)
+	{
+		if (saved >= 0)
+			dup2(saved, 1), close(saved);
+		return (-2);
+	}
+	fd = open("/dev/null", O_WRONLY | O_CLOEXEC);
+	if (fd == -1)
+		return (-2);
+	saved = dup(1);
+	if (saved != -1 && dup2(fd, 1) == -1)
+		close(saved), saved = -2;
+	close(fd);
+	return (saved == -1 ? -2 : saved);
+}
+
+/**
+ * bench_putchar - Writes characters to /dev/null with _putchar().
+ * @b: The case, one character per operation.
+ *
+ * Return: void.
+ */
+void bench_putchar(bench_t *b)
+{
+	int saved = to_null(-1);
+	long i;
+
+	b->bytes = 1;
+	bench_start(b);
+	for (i = 0; i < b->n; i++)
+		_putchar('x');
+	_putchar(BUFFER_FLUSH);
+	bench_stop(b);
+	to_null(saved);
+}
+
+/**
+ * bench_puts - Writes strings to /dev/null with _puts().
+ * @b: The case, strings of @arg bytes.
+ *
+ * Return: void.
+ */
+void bench_puts(bench_t *b)
+{
+	char s[4096 + 1];
+	int saved = to_null(-1);
+	long i;
+
+	for (i = 0; i < b->arg && i < 4096; i++)
+		s[i] = 'a' + i % 26;
+	s[i] = '\0';
+	b->bytes = i;
+	bench_start(b);
+	for (i = 0; i < b->n; i++)
+		_puts(s);
+	_putchar(BUFFER_FLUSH);
+	bench_stop(b);
+	to_null(saved);
+}
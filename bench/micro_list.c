@@ -0,0 +1,136 @@
+#include "micro.h"
+
+static volatile long sink;
+
+/**
+ * make_list - Builds a list of environment-like strings.
+ * @head: Where to put the list.
+ * @n: Its length, the strings are "VAR0=value" to "VARn-1=value".
+ * @last: A buffer for the name of the last variable, "VARn-1".
+ *
+ * The list is built from its end, so that it takes linear time.
+ *
+ * Return: The last node, NULL if the list is empty or allocation failed.
+ */
+static list_t *make_list(list_t **head, long n, char *last)
+{
+	char s[64];
+	list_t *tail = NULL;
+	long i;
+
+	*head = NULL;
+	for (i = n - 1; i >= 0; i--)
+	{
+		_strcpy(s, "VAR");
+		_strcat(s, convert_num_to_str(i, 10, 0));
+		if (i == n - 1)
+			_strcpy(last, s);
+		_strcat(s, "=value");
+		if (!add_node(head, s, 0))
+			return (NULL);
+		if (!tail)
+			tail = *head;
+	}
+	return (tail);
+}
+
+/**
+ * bench_add_node_end - Appends a node to a list with add_node_end().
+ * @b: The case, the list holds @arg nodes.
+ *
+ * The new node is taken off again each time, so the list keeps its
+ * length.
+ *
+ * Return: void.
+ */
+void bench_add_node_end(bench_t *b)
+{
+	list_t *head, *tail, *node;
+	char last[64];
+	long i;
+
+	tail = make_list(&head, b->arg, last);
+	bench_start(b);
+	for (i = 0; tail && i < b->n; i++)
+	{
+		node = add_node_end(&head, "NEW=1", 0);
+		if (!node)
+			break;
+		tail->next = NULL;
+		free(node->str);
+		free(node);
+	}
+	bench_stop(b);
+	free_list(&head);
+}
+
+/**
+ * bench_starts_with - Looks up the last variable of a list with
+ *	node_starts_with(), as the alias builtin does.
+ * @b: The case, the list holds @arg nodes.
+ *
+ * Return: void.
+ */
+void bench_starts_with(bench_t *b)
+{
+	list_t *head;
+	char last[64];
+	long i;
+
+	make_list(&head, b->arg, last);
+	bench_start(b);
+	for (i = 0; i < b->n; i++)
+		sink += node_starts_with(head, last, '=') != NULL;
+	bench_stop(b);
+	free_list(&head);
+}
+
+/**
+ * bench_to_strings - Copies a list into a string array with
+ *	list_to_strings(), and frees it.
+ * @b: The case, the list holds @arg nodes.
+ *
+ * Return: void.
+ */
+void bench_to_strings(bench_t *b)
+{
+	list_t *head;
+	char last[64];
+	long i;
+
+	make_list(&head, b->arg, last);
+	bench_start(b);
+	for (i = 0; i < b->n; i++)
+		ffree(list_to_strings(head));
+	bench_stop(b);
+	free_list(&head);
+}
+
+/**
+ * bench_hist_add - Appends a line to a full history with hist_add().
+ * @b: The case, HISTSIZE is @arg.
+ *
+ * Each line added drops the oldest one, the steady state of a long
+ * interactive session.
+ *
+ * Return: void.
+ */
+void bench_hist_add(bench_t *b)
+{
+	param_t info[] = { PARAM_INIT };
+	char line[] = "ls -l /usr/lib | grep x";
+	long i;
+
+	info->hist = hist_new();
+	if (!info->hist)
+		return;
+	info->hist->cap = b->arg;
+	for (i = 0; i < b->arg; i++)
+		hist_add(info, line, sizeof(line) - 1);
+	bench_start(b);
+	for (i = 0; i < b->n; i++)
+		hist_add(info, line, sizeof(line) - 1);
+	bench_stop(b);
+	sink += info->histcount;
+	hist_free(info);
+}
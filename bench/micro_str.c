@@ -0,0 +1,88 @@
+#include "micro.h"
+
+static volatile long sink;
+
+/**
+ * make_line - Fills a buffer with a command line of some words.
+ * @line: The buffer, 8 bytes per word and one more.
+ * @words: The number of words.
+ *
+ * Return: The length of the line.
+ */
+static long make_line(char *line, long words)
+{
+	char *w[] = {"ls ", "-la ", "/usr/bin ", "grep ", "-v ", "foo.c "};
+	long i, k = 0;
+	char *s;
+
+	for (i = 0; i < words; i++)
+		for (s = w[i % 6]; *s; s++)
+			line[k++] = *s;
+	line[k ? k - 1 : 0] = '\0';
+	return (k ? k - 1 : 0);
+}
+
+/**
+ * bench_strtok - Splits a line into words with _strtok() and frees them.
+ * @b: The case, @arg words per line.
+ *
+ * Return: void.
+ */
+void bench_strtok(bench_t *b)
+{
+	char line[8 * 1024 + 1];
+	char **av;
+	long i;
+
+	b->bytes = make_line(line, b->arg);
+	bench_start(b);
+	for (i = 0; i < b->n; i++)
+	{
+		av = _strtok(line, " \t");
+		sink += av != NULL;
+		ffree(av);
+	}
+	bench_stop(b);
+}
+
+/**
+ * bench_strtok2 - Splits a line into words with _strtok2() and frees them.
+ * @b: The case, @arg words per line.
+ *
+ * Return: void.
+ */
+void bench_strtok2(bench_t *b)
+{
+	char line[8 * 1024 + 1];
+	char **av;
+	long i;
+
+	b->bytes = make_line(line, b->arg);
+	bench_start(b);
+	for (i = 0; i < b->n; i++)
+	{
+		av = _strtok2(line, ' ');
+		sink += av != NULL;
+		ffree(av);
+	}
+	bench_stop(b);
+}
+
+/**
+ * bench_is_delim - Classifies the characters of a line with is_delim().
+ * @b: The case, one character per operation.
+ *
+ * Return: void.
+ */
+void bench_is_delim(bench_t *b)
+{
+	char line[8 * 1024 + 1];
+	long i, len = make_line(line, 1024), k = 0;
+
+	b->bytes = 1;
+	bench_start(b);
+	for (i = 0; i < b->n; i++)
+		k += is_delim(line[i % len], " \t;&|<>");
+	bench_stop(b);
+	sink += k;
+}
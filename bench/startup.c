@@ -0,0 +1,171 @@
+#include "e2e.h"
+
+/*
+ * Startup latency of this shell against the other POSIX shells
+ * installed: how long from fork() and exec until the first command of
+ * a script has run, and until the shell has exited.
+ *
+ *	gcc -O2 -std=gnu89 -o startup bench/startup.c bench/e2e_gen.c \
+ *		bench/e2e_sys.c
+ *	./startup [-w case] ./hsh [shell...]
+ *
+ * The script of each case only echoes a word; the first byte of it on
+ * the pipe the shell writes to marks the first command. The cases of
+ * e2e_gen.c vary the size of the environment and of the history file,
+ * and whether the script is named or given on standard input. Each
+ * shell starts STARTUP_RUNS times per case after one warm-up start;
+ * the median and 90th percentile are printed as JSON, in microseconds.
+ * The history file is written once per shell and case, and the shell
+ * keeps it up from there as it would between sessions.
+ */
+
+/**
+ * since - Gets the time elapsed since a point.
+ * @t0: The point.
+ *
+ * Return: The time, in nanoseconds.
+ */
+static long since(struct timespec *t0)
+{
+	struct timespec t;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return ((t.tv_sec - t0->tv_sec) * 1000000000L
+			+ (t.tv_nsec - t0->tv_nsec));
+}
+
+/**
+ * long_cmp - Orders times, for qsort().
+ * @a: A time.
+ * @b: Another.
+ *
+ * Return: Less than, equal to or greater than 0 as @a is.
+ */
+static int long_cmp(const void *a, const void *b)
+{
+	long x = *(const long *)a, y = *(const long *)b;
+
+	return (x < y ? -1 : x > y);
+}
+
+/**
+ * start_once - Starts a shell on a script and times it.
+ * @sh: The shell.
+ * @w: The case.
+ * @script: Its script.
+ * @env: The environment of the shell.
+ * @home: Its working directory.
+ * @t: Where to store the time to the first output, then to the exit,
+ *	in nanoseconds.
+ * @rss: The peak RSS seen so far, in KiB, updated.
+ *
+ * Return: 0 on success, -1 if the shell failed or printed nothing.
+ */
+static int start_once(char *sh, workload_t *w, char *script, char **env,
+		char *home, long t[2], long *rss)
+{
+	struct timespec t0;
+	struct rusage ru;
+	char buf[256];
+	int fds[2], status = -1;
+	ssize_t n;
+	pid_t pid;
+
+	if (pipe2(fds, O_CLOEXEC))
+		return (-1);
+	clock_gettime(CLOCK_MONOTONIC, &t0);
+	pid = spawn(sh, w, script, env, home, fds[1]);
+	close(fds[1]);
+	n = pid == -1 ? -1 : read(fds[0], buf, sizeof(buf));
+	t[0] = since(&t0);
+	if (n <= 0)
+		t[0] = -1;
+	while (n > 0)
+		n = read(fds[0], buf, sizeof(buf));
+	close(fds[0]);
+	if (pid == -1 || wait4(pid, &status, 0, &ru) == -1)
+		return (-1);
+	t[1] = since(&t0);
+	if (ru.ru_maxrss > *rss)
+		*rss = ru.ru_maxrss;
+	if (t[0] < 0 || !WIFEXITED(status) || WEXITSTATUS(status))
+		return (-1);
+	return (0);
+}
+
+/**
+ * run_case - Times the starts of each shell on a case and prints them.
+ * @w: The case.
+ * @shells: The shells.
+ * @dir: The scratch directory.
+ * @first: 1 until a result was printed.
+ *
+ * Return: 0 on success, -1 if the case could not be set up.
+ */
+static int run_case(workload_t *w, char **shells, char *dir, int *first)
+{
+	char *script = gen_script(w, dir), **env = gen_env(w, dir), *hist;
+	static long t[2][STARTUP_RUNS];
+	long one[2] = {0, 0}, rss;
+	int i, k, status;
+	size_t len;
+
+	hist = gen_history(w, &len);
+	for (i = 0; script && env && shells[i]; i++, *first = 0)
+	{
+		status = put_history(dir, hist, len);
+		for (rss = 0, k = -1; k < w->runs; k++)
+		{
+			if (start_once(shells[i], w, script, env, dir, one,
+						&rss))
+				status = -1;
+			if (k >= 0)
+				t[0][k] = one[0], t[1][k] = one[1];
+		}
+		qsort(t[0], w->runs, sizeof(long), long_cmp);
+		qsort(t[1], w->runs, sizeof(long), long_cmp);
+		printf("%s\n  {\"case\": \"%s\", \"shell\": \"%s\", ",
+				*first ? "" : ",", w->name, shells[i]);
+		printf("\"runs\": %d, \"first_cmd_us_p50\": %.1f, ", w->runs,
+				t[0][w->runs / 2] / 1e3);
+		printf("\"first_cmd_us_p90\": %.1f, ",
+				t[0][w->runs * 9 / 10] / 1e3);
+		printf("\"exit_us_p50\": %.1f, ", t[1][w->runs / 2] / 1e3);
+		printf("\"peak_rss_kb\": %ld, \"status\": %d}", rss, status);
+		fflush(stdout);
+	}
+	i = script && env ? 0 : -1;
+	free(script), free_env(env), free(hist);
+	return (i);
+}
+
+/**
+ * main - Runs the startup benchmarks and prints the results as JSON.
+ * @ac: The argument count.
+ * @av: The arguments: [-w case] shell [shell...].
+ *
+ * Return: 0 on success, 1 on failure.
+ */
+int main(int ac, char **av)
+{
+	char *shells[E2E_SHELLS], *only = NULL, *name = av[0];
+	char dir[] = "/tmp/hsh-startup-XXXXXX";
+	int i, first = 1, ret = 0;
+
+	if (ac > 2 && !strcmp(av[1], "-w"))
+		only = av[2], ac -= 2, av += 2;
+	if (ac < 2)
+	{
+		fprintf(stderr, "usage: %s [-w case] hsh [shell...]\n", name);
+		return (1);
+	}
+	if (!find_shells(shells, ac - 1, av + 1) || !mkdtemp(dir))
+		return (perror(av[1]), 1);
+	printf("{\"benchmarks\": [");
+	for (i = 0; startups[i].name; i++)
+		if (!only || !strcmp(only, startups[i].name))
+			ret |= run_case(&startups[i], shells, dir, &first);
+	printf("\n]}\n");
+	rm_tree(dir);
+	return (ret ? 1 : 0);
+}
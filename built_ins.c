@@ -7,11 +7,36 @@
  * @info: Structure containing potential arguments. Used to maintain
  *        a constant function prototype.
  *
- * Return: Always 0
+ * Usage: history [--stats | -n | -s pattern]. With --stats, prints the
+ * count, failures and p50/p95/p99 wall clock times of the timed entries
+ * of each command name instead. With -n, adds the entries other shells
+ * appended to the history file since it was last read, and prints
+ * nothing. With -s, prints only the entries that contain the pattern,
+ * the words after it joined by spaces, or start with it after a
+ * leading '^'. At most HISTSIZE entries are kept.
+ *
+ * Return: 0, 1 (also the exit status) if history -n found no history
+ *	file or history -s no entry
  */
 int _history(param_t *info)
 {
-	print_list(info->history);
+	hist_ring_t *r;
+	size_t i;
+
+	hist_load(info);
+	if (info->argv[1] && !_strcmp(info->argv[1], "--stats"))
+		return (hist_stats(info));
+	if (info->argv[1] && !_strcmp(info->argv[1], "-n"))
+		return (info->status = hist_pull(info) ? 1 : 0);
+	if (info->argv[1] && !_strcmp(info->argv[1], "-s"))
+		return (info->status = !hist_search(info, info->argv + 2));
+	for (r = info->hist, i = 0; r && i < r->count; i++)
+	{
+		_puts(convert_num_to_str(r->base + i, 10, 0));
+		_puts(": ");
+		_puts(r->arena + r->ent[(r->first + i) % r->slots].off);
+		_putchar('\n');
+	}
 	return (0);
 }
 
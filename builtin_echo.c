@@ -0,0 +1,127 @@
+#include "shell.h"
+
+/**
+ * put_escape - Prints the backslash escape sequence at *s.
+ * @s: Address of a pointer to the backslash, moved to the last
+ *	character of the sequence.
+ * @bmode: If true use the echo and %b rules: \c stops the output and
+ *	octal escapes are written \0nnn.
+ *
+ * Return: 1 if the output must stop here, 0 otherwise.
+ */
+int put_escape(char **s, int bmode)
+{
+	char *map = "a\ab\bf\fn\nr\rt\tv\v\\\\", *p = *s + 1;
+	int i, k, n = 0;
+
+	if (!*p)
+		return (_putchar('\\'), 0);
+	*s = p;
+	if (*p == 'c' && bmode)
+		return (1);
+	for (i = 0; map[i] && map[i] != *p; i += 2)
+		;
+	if (map[i])
+		return (_putchar(map[i + 1]), 0);
+	if (*p < '0' || *p > '7')
+		return (_putchar('\\'), _putchar(*p), 0);
+	k = bmode && *p == '0' ? 4 : 3;
+	for (; k-- && *p >= '0' && *p <= '7'; p++)
+		n = n * 8 + *p - '0';
+	*s = p - 1;
+	_putchar(n);
+	return (0);
+}
+
+/**
+ * _echo - Prints its arguments separated by spaces (man echo).
+ * @info: Structure containing potential arguments. Used to maintain
+ *        a constant function prototype.
+ *
+ * A first argument of -n suppresses the newline; backslash escapes are
+ * interpreted as XSI echo does.
+ *
+ * Return: Always 0.
+ */
+int _echo(param_t *info)
+{
+	int i = 1, newline = 1;
+	char *s;
+
+	if (info->argv[1] && !_strcmp(info->argv[1], "-n"))
+		newline = 0, i++;
+	for (; info->argv[i]; i++)
+	{
+		for (s = info->argv[i]; *s; s++)
+		{
+			if (*s != '\\')
+				_putchar(*s);
+			else if (put_escape(&s, 1))
+				return (info->status = 0);
+		}
+		if (info->argv[i + 1])
+			_putchar(' ');
+	}
+	if (newline)
+		_putchar('\n');
+	return (info->status = 0);
+}
+
+/**
+ * _pwd - Prints the current working directory (man pwd).
+ * @info: Structure containing potential arguments. Used to maintain
+ *        a constant function prototype.
+ *
+ * With -L, the default, $PWD is printed when it names the current
+ * directory; -P always prints the physical path.
+ *
+ * Return: 0 on success, 1 on failure.
+ */
+int _pwd(param_t *info)
+{
+	char *pwd = _getenv(info, "PWD="), buffer[PATH_MAX];
+	struct stat a, b;
+
+	if (info->argv[1] && _strcmp(info->argv[1], "-P")
+			&& _strcmp(info->argv[1], "-L"))
+	{
+		_perror(info, "Illegal option ");
+		_eputs(info->argv[1]), _eputchar('\n');
+		return (info->status = 2);
+	}
+	if (!info->argv[1] || !_strcmp(info->argv[1], "-L"))
+		if (pwd && *pwd == '/' && !stat(pwd, &a) && !stat(".", &b)
+				&& a.st_dev == b.st_dev && a.st_ino == b.st_ino)
+			return (_puts(pwd), _putchar('\n'), info->status = 0);
+	if (!getcwd(buffer, PATH_MAX))
+	{
+		_perror(info, "can't get the current directory\n");
+		return (info->status = 1);
+	}
+	_puts(buffer), _putchar('\n');
+	return (info->status = 0);
+}
+
+/**
+ * _true - Does nothing, successfully (man true).
+ * @info: Structure containing potential arguments. Used to maintain
+ *        a constant function prototype.
+ *
+ * Return: Always 0.
+ */
+int _true(param_t *info)
+{
+	return (info->status = 0);
+}
+
+/**
+ * _false - Does nothing, unsuccessfully (man false).
+ * @info: Structure containing potential arguments. Used to maintain
+ *        a constant function prototype.
+ *
+ * Return: Always 1.
+ */
+int _false(param_t *info)
+{
+	return (info->status = 1);
+}
@@ -0,0 +1,157 @@
+#include "shell.h"
+
+/**
+ * printf_num - Converts a printf argument to a number.
+ * @arg: The argument, NULL is 0 and 'c is the code of c.
+ * @err: Set to 1 when the argument is not a valid number.
+ *
+ * Return: The number.
+ */
+static long printf_num(char *arg, int *err)
+{
+	char *end;
+	long n;
+
+	if (!arg || !*arg)
+		return (0);
+	if (*arg == '\'' || *arg == '"')
+		return ((unsigned char)arg[1]);
+	errno = 0;
+	n = strtol(arg, &end, 0);
+	if (*end || errno)
+	{
+		_eputs("printf: ");
+		_eputs(arg);
+		_eputs(": invalid number\n");
+		*err = 1;
+	}
+	return (n);
+}
+
+/**
+ * printf_pad - Prints a converted value padded to a field width.
+ * @s: The converted value.
+ * @len: How many characters of s to print.
+ * @width: The field width.
+ * @flags: Bit 0 for '-' (pad on the right), bit 1 for '0' padding.
+ *
+ * Return: void.
+ */
+static void printf_pad(char *s, int len, int width, int flags)
+{
+	int i;
+
+	if ((flags & 2) && !(flags & 1) && *s == '-')
+		_putchar(*s++), len--, width--;
+	for (i = len; !(flags & 1) && i < width; i++)
+		_putchar(flags & 2 ? '0' : ' ');
+	for (i = 0; i < len; i++)
+		_putchar(s[i]);
+	for (i = len; (flags & 1) && i < width; i++)
+		_putchar(' ');
+}
+
+/**
+ * printf_b - Prints a %b argument, interpreting its backslash escapes.
+ * @s: The argument.
+ *
+ * Return: 1 if the argument was printed, -1 if \c stopped the output.
+ */
+static int printf_b(char *s)
+{
+	for (; *s; s++)
+		if (*s != '\\')
+			_putchar(*s);
+		else if (put_escape(&s, 1))
+			return (-1);
+	return (1);
+}
+
+/**
+ * printf_conv - Prints one conversion of a printf format.
+ * @fmt: Address of a pointer to the character after '%', moved to the
+ *	conversion character.
+ * @arg: The argument to convert, or NULL when they are used up.
+ * @err: Set to 1 on an invalid numeric argument.
+ *
+ * Return: 1 if arg was used, 0 if not, -1 if \c in a %b stopped output.
+ */
+static int printf_conv(char **fmt, char *arg, int *err)
+{
+	char *f = *fmt, *s = arg ? arg : "", c[2] = {0, 0};
+	int flags = 0, width = 0, prec = -1, len;
+	long n;
+
+	for (; *f == '-' || *f == '0'; f++)
+		flags |= *f == '-' ? 1 : 2;
+	for (; *f >= '0' && *f <= '9'; f++)
+		width = width * 10 + *f - '0';
+	if (*f == '.')
+		for (prec = 0, f++; *f >= '0' && *f <= '9'; f++)
+			prec = prec * 10 + *f - '0';
+	*fmt = f;
+	if (*f == 'b')
+		return (printf_b(s));
+	if (*f == 'c')
+		c[0] = *s, s = c;
+	else if (*f && is_delim(*f, "diuoxX"))
+	{
+		n = printf_num(arg, err);
+		s = convert_num_to_str(n, *f == 'o' ? 8 : *f == 'x' || *f == 'X'
+				? 16 : 10, (*f == 'x' ? CONVERT_LC : 0) |
+				(is_delim(*f, "di") ? 0 : CONVERT_UNSIGNED));
+	}
+	else if (*f != 's')
+	{
+		_putchar('%');
+		if (*f)
+			_putchar(*f);
+		else
+			(*fmt)--;
+		return (0);
+	}
+	len = _strlen(s);
+	if (*f == 's' && prec >= 0 && prec < len)
+		len = prec;
+	printf_pad(s, len, width, *f == 's' ? flags & 1 : flags);
+	return (1);
+}
+
+/**
+ * _printf - Formats and prints its arguments (man printf).
+ * @info: Structure containing potential arguments. Used to maintain
+ *        a constant function prototype.
+ *
+ * The format is reused while arguments are left, as POSIX requires.
+ *
+ * Return: 0 on success, 1 on an invalid number, 2 on a usage error.
+ */
+int _printf(param_t *info)
+{
+	char *f;
+	int i = 2, used, ret = 0, err = 0;
+
+	if (!info->argv[1])
+	{
+		_perror(info, "usage: printf format [arg ...]\n");
+		return (info->status = 2);
+	}
+	do {
+		used = 0;
+		for (f = info->argv[1]; *f && ret >= 0; f++)
+			if (*f == '\\')
+				put_escape(&f, 0);
+			else if (*f == '%' && f[1] == '%')
+				_putchar(*f++);
+			else if (*f == '%')
+			{
+				f++;
+				ret = printf_conv(&f, info->argv[i], &err);
+				if (ret > 0 && info->argv[i])
+					i++, used = 1;
+			}
+			else
+				_putchar(*f);
+	} while (ret >= 0 && used && info->argv[i]);
+	return (info->status = err);
+}
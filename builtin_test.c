@@ -0,0 +1,183 @@
+#include "shell.h"
+
+/**
+ * test_unary - Evaluates a unary test primary.
+ * @op: The operator, such as -f.
+ * @arg: The operand.
+ *
+ * Return: 0 if true, 1 if false, -1 if op is not a unary operator.
+ */
+static int test_unary(char *op, char *arg)
+{
+	struct stat st;
+	char *ops = "efdrwxsLhpSbcnzt";
+	int i;
+
+	if (op[0] != '-' || !op[1] || op[2])
+		return (-1);
+	for (i = 0; ops[i] && ops[i] != op[1]; i++)
+		;
+	if (!ops[i])
+		return (-1);
+	if (op[1] == 'n' || op[1] == 'z')
+		return ((op[1] == 'n') == !*arg);
+	if (op[1] == 't')
+		return (!isatty(_atoi(arg)));
+	if (op[1] == 'r' || op[1] == 'w' || op[1] == 'x')
+		return (access(arg, op[1] == 'r' ? R_OK : op[1] == 'w' ? W_OK
+					: X_OK) != 0);
+	if ((op[1] == 'L' || op[1] == 'h') ? lstat(arg, &st) : stat(arg, &st))
+		return (1);
+	switch (op[1])
+	{
+	case 'f': return (!S_ISREG(st.st_mode));
+	case 'd': return (!S_ISDIR(st.st_mode));
+	case 's': return (st.st_size == 0);
+	case 'L': case 'h': return (!S_ISLNK(st.st_mode));
+	case 'p': return (!S_ISFIFO(st.st_mode));
+	case 'S': return (!S_ISSOCK(st.st_mode));
+	case 'b': return (!S_ISBLK(st.st_mode));
+	case 'c': return (!S_ISCHR(st.st_mode));
+	}
+	return (0);
+}
+
+/**
+ * test_int - Parses an integer operand of test.
+ * @s: The operand.
+ * @n: Where to store the value.
+ *
+ * Return: 0 on success, -1 if s is not an integer.
+ */
+static int test_int(char *s, long *n)
+{
+	char *end;
+
+	errno = 0;
+	*n = strtol(s, &end, 10);
+	if (!*s || *end || errno)
+	{
+		_eputs("test: ");
+		_eputs(s);
+		_eputs(": bad number\n");
+		return (-1);
+	}
+	return (0);
+}
+
+/**
+ * test_binary - Evaluates a binary test primary.
+ * @a: The left operand.
+ * @op: The operator, such as = or -lt.
+ * @b: The right operand.
+ *
+ * Return: 0 if true, 1 if false, 2 on a bad number, -1 if op is not a
+ *	binary operator.
+ */
+static int test_binary(char *a, char *op, char *b)
+{
+	char *ops[] = {"-eq", "-ne", "-lt", "-le", "-gt", "-ge", NULL};
+	struct stat sa, sb;
+	long x, y;
+	int i;
+
+	if (!_strcmp(op, "=") || !_strcmp(op, "!="))
+		return (!_strcmp(a, b) == (op[0] == '!'));
+	if (!_strcmp(op, "-nt") || !_strcmp(op, "-ot") || !_strcmp(op, "-ef"))
+	{
+		if (stat(a, &sa) || stat(b, &sb))
+			return (1);
+		if (op[1] == 'e')
+			return (sa.st_dev != sb.st_dev
+					|| sa.st_ino != sb.st_ino);
+		return (op[1] == 'n' ? !(sa.st_mtime > sb.st_mtime)
+				: !(sa.st_mtime < sb.st_mtime));
+	}
+	for (i = 0; ops[i] && _strcmp(op, ops[i]); i++)
+		;
+	if (!ops[i])
+		return (-1);
+	if (test_int(a, &x) || test_int(b, &y))
+		return (2);
+	switch (i)
+	{
+	case 0: return (!(x == y));
+	case 1: return (!(x != y));
+	case 2: return (!(x < y));
+	case 3: return (!(x <= y));
+	case 4: return (!(x > y));
+	}
+	return (!(x >= y));
+}
+
+/**
+ * test_expr - Evaluates the arguments of test with the POSIX rules.
+ * @av: The arguments.
+ * @n: The number of arguments.
+ *
+ * Up to four arguments are decided by their count: with three, a binary
+ * primary in the middle, -a and -o included, comes before a leading !
+ * and before parentheses. Longer expressions are split on -o, then on
+ * -a.
+ *
+ * Return: 0 if true, 1 if false, 2 on error.
+ */
+int test_expr(char **av, int n)
+{
+	int i, k, r = -1, l;
+
+	for (i = n > 4 || n == 3 ? 1 : n; i < n - 1 && _strcmp(av[i], "-o");)
+		i++;
+	for (k = n > 4 || n == 3 ? 1 : n; k < n - 1 && _strcmp(av[k], "-a");)
+		k++;
+	i = i < n - 1 ? i : k;
+	if (i < n - 1)
+	{
+		l = test_expr(av, i);
+		r = test_expr(av + i + 1, n - i - 1);
+		if (l == 2 || r == 2)
+			return (2);
+		return (av[i][1] == 'o' ? l && r : l || r);
+	}
+	if (n == 0 || n == 1)
+		return (n ? !*av[0] : 1);
+	if (n == 3)
+		r = test_binary(av[0], av[1], av[2]);
+	if (r == -1 && n <= 4 && !_strcmp(av[0], "!"))
+		return ((r = test_expr(av + 1, n - 1)) == 2 ? 2 : !r);
+	if (n == 2)
+		r = test_unary(av[0], av[1]);
+	else if (r == -1 && n == 3 && !_strcmp(av[0], "(")
+			&& !_strcmp(av[2], ")"))
+		r = test_expr(av + 1, 1);
+	else if (n == 4 && !_strcmp(av[0], "(") && !_strcmp(av[3], ")"))
+		r = test_expr(av + 1, 2);
+	if (r == -1)
+		_eputs("test: syntax error\n");
+	return (r == -1 ? 2 : r);
+}
+
+/**
+ * _test - Evaluates a conditional expression (man test).
+ * @info: Structure containing potential arguments. Used to maintain
+ *        a constant function prototype.
+ *
+ * When called as [ the last argument must be ].
+ *
+ * Return: 0 if the expression is true, 1 if false, 2 on error.
+ */
+int _test(param_t *info)
+{
+	int n = info->argc - 1;
+
+	if (info->argv[0][0] == '[')
+	{
+		if (!n || _strcmp(info->argv[n], "]"))
+		{
+			_perror(info, "missing ]\n");
+			return (info->status = 2);
+		}
+		n--;
+	}
+	return (info->status = test_expr(info->argv + 1, n));
+}
@@ -0,0 +1,93 @@
+#include "shell.h"
+
+/**
+ * bc_put_num - Appends a little-endian number to a bytecode buffer.
+ * @sb: The bytecode buffer.
+ * @v: The number.
+ * @n: Its size in bytes.
+ *
+ * Return: 0 on success, -1 on allocation failure.
+ */
+int bc_put_num(strbuf_t *sb, unsigned long v, int n)
+{
+	char b[8];
+	int i;
+
+	for (i = 0; i < n; i++, v >>= 8)
+		b[i] = v & 0xff;
+	return (sb_append(sb, b, n));
+}
+
+/**
+ * bc_get_num - Reads a little-endian number from a bytecode buffer.
+ * @sb: The bytecode buffer.
+ * @pos: Address of the read position, moved past the number; it is
+ *	set past the end of the buffer if the number does not fit.
+ * @n: The size of the number in bytes.
+ *
+ * Return: The number, 0 when it does not fit.
+ */
+unsigned long bc_get_num(strbuf_t *sb, size_t *pos, int n)
+{
+	unsigned long v = 0;
+	int i;
+
+	if (*pos + n > sb->len)
+	{
+		*pos = sb->len + 1;
+		return (0);
+	}
+	for (i = n; i--;)
+		v = (v << 8) | (unsigned char)sb->s[*pos + i];
+	*pos += n;
+	return (v);
+}
+
+/**
+ * bc_put_word - Appends a word to a bytecode buffer.
+ * @sb: The bytecode buffer.
+ * @w: The word, written as its length and its bytes.
+ *
+ * Return: 0 on success, -1 on allocation failure.
+ */
+static int bc_put_word(strbuf_t *sb, char *w)
+{
+	int len = _strlen(w);
+
+	return (bc_put_num(sb, len, 4) || sb_append(sb, w, len) ? -1 : 0);
+}
+
+/**
+ * bc_put_line - Compiles a parsed line into bytecode.
+ * @sb: The bytecode buffer.
+ * @line: The line number in the script.
+ * @cmd: The parsed line.
+ *
+ * A line is BC_LINE and its number, then for every command BC_CMD, the
+ * operator, the time keyword flag, the word and redirection counts,
+ * each word, and each redirection as its type, its fd and its word.
+ *
+ * Return: 0 on success, -1 on allocation failure.
+ */
+int bc_put_line(strbuf_t *sb, unsigned int line, cmd_t *cmd)
+{
+	int i, n, err;
+	redir_t *r;
+
+	err = bc_put_num(sb, BC_LINE, 1) || bc_put_num(sb, line, 4);
+	for (; cmd && !err; cmd = cmd->next)
+	{
+		for (n = 0, r = cmd->redirs; r; r = r->next)
+			n++;
+		err = bc_put_num(sb, BC_CMD, 1) || bc_put_num(sb, cmd->op, 1)
+			|| bc_put_num(sb, cmd->timed, 1)
+			|| bc_put_num(sb, cmd->argc, 2) || bc_put_num(sb, n, 2);
+		for (i = 0; i < cmd->argc && !err; i++)
+			err = bc_put_word(sb, cmd->argv[i]);
+		for (r = cmd->redirs; r && !err; r = r->next)
+			err = bc_put_num(sb, r->type, 1)
+				|| bc_put_num(sb, r->fd, 1)
+				|| bc_put_word(sb, r->word);
+	}
+	return (err ? -1 : 0);
+}
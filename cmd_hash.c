@@ -0,0 +1,161 @@
+#include "shell.h"
+
+/**
+ * path_stamp - Records the modification times of the PATH directories.
+ * @pathstr: The PATH string.
+ * @stamps: The mtimes recorded before, one struct timespec per PATH
+ *	entry in order, zero for one that does not exist; updated.
+ *
+ * Installing or removing a program in a PATH directory changes that
+ * directory's mtime. Each is compared on its own and to the
+ * nanosecond, so no change can hide behind another or in the second of
+ * the last check.
+ *
+ * Return: 1 if any mtime or the number of entries changed, or on
+ *	allocation failure, 0 if not.
+ */
+int path_stamp(char *pathstr, strbuf_t *stamps)
+{
+	int i = 0, curr_pos = 0, changed = 0;
+	size_t k = 0, size = sizeof(struct timespec);
+	struct timespec ts;
+	struct stat st;
+	char *dir;
+
+	for (; pathstr; i++)
+		if (!pathstr[i] || pathstr[i] == ':')
+		{
+			dir = dup_chars(pathstr, curr_pos, i);
+			_memset((void *)&ts, 0, size);
+			if (!stat(*dir ? dir : ".", &st))
+				ts = st.st_mtim;
+			if (k == stamps->len)
+			{
+				if (sb_append(stamps, (char *)&ts, size))
+					return (stamps->len = 0, 1);
+				changed = 1;
+			}
+			else if (memcmp(stamps->s + k, &ts, size))
+				memcpy(stamps->s + k, &ts, size), changed = 1;
+			k += size;
+			if (!pathstr[i])
+				break;
+			curr_pos = i;
+		}
+	if (stamps->len != k)
+		stamps->len = k, changed = 1;
+	return (changed);
+}
+
+/**
+ * hash_clear - Forgets every remembered command location.
+ * @info: Pointer to the info struct.
+ *
+ * Return: void.
+ */
+void hash_clear(param_t *info)
+{
+	int i;
+
+	if (!info->cmdhash)
+		return;
+	for (i = 0; i < CMD_HASH_SIZE; i++)
+		free_list(&(info->cmdhash->bucket[i]));
+	sb_free(&(info->cmdhash->stamps));
+}
+
+/**
+ * hash_fresh - Makes sure the hash table is usable for this PATH.
+ * @info: Pointer to the info struct.
+ * @pathstr: The PATH string.
+ *
+ * The PATH directories are stat'ed on every lookup, which costs far less
+ * than the command about to start; the table is emptied when any of
+ * their mtimes changed since it was filled.
+ *
+ * Return: The hash table, or NULL if it could not be allocated.
+ */
+static cmd_hash_t *hash_fresh(param_t *info, char *pathstr)
+{
+	cmd_hash_t *h = info->cmdhash;
+
+	if (!h)
+	{
+		h = malloc(sizeof(cmd_hash_t));
+		if (!h)
+			return (NULL);
+		_memset((void *)h, 0, sizeof(cmd_hash_t));
+		info->cmdhash = h;
+	}
+	if (path_stamp(pathstr, &(h->stamps)))
+	{
+		hash_clear(info);
+		path_stamp(pathstr, &(h->stamps));
+	}
+	return (h);
+}
+
+/**
+ * hash_remember - Stores the result of a PATH search.
+ * @bucket: Address of the bucket chain to add to.
+ * @cmd: The command name.
+ * @path: The full path found, or NULL for a miss.
+ *
+ * Return: The value of the new entry, or NULL for a miss.
+ */
+static char *hash_remember(list_t **bucket, char *cmd, char *path)
+{
+	char *buf;
+	list_t *node;
+
+	buf = malloc(_strlen(cmd) + _strlen(path) + 2);
+	if (!buf)
+		return (path);
+	_strcpy(buf, cmd);
+	_strcat(buf, "=");
+	if (path)
+		_strcat(buf, path);
+	node = add_node(bucket, buf, 0);
+	free(buf);
+	if (!node)
+		return (path);
+	return (path ? node->str + _strlen(cmd) + 1 : NULL);
+}
+
+/**
+ * hash_find - Finds a command in PATH, remembering the answer.
+ * @info: Pointer to the info struct.
+ * @cmd: The command to find.
+ *
+ * Names containing a '/' and results relative to the current directory
+ * are never remembered. Misses are remembered as well, so a typo in a
+ * loop does not search PATH on every iteration.
+ *
+ * Return: Full path of the command if found, or NULL if not found.
+ */
+char *hash_find(param_t *info, char *cmd)
+{
+	char *pathstr = _getenv(info, "PATH="), *path;
+	cmd_hash_t *h;
+	list_t **bucket, *node;
+
+	if (!pathstr || !cmd || !*cmd || _strchr(cmd, '/'))
+		return (find_path(info, pathstr, cmd));
+	h = hash_fresh(info, pathstr);
+	if (!h)
+		return (find_path(info, pathstr, cmd));
+	bucket = &(h->bucket[hash_str(cmd) % CMD_HASH_SIZE]);
+	node = node_starts_with(*bucket, cmd, '=');
+	if (node)
+	{
+		h->hits++;
+		node->num++;
+		path = node->str + _strlen(cmd) + 1;
+		return (*path ? path : NULL);
+	}
+	h->misses++;
+	path = find_path(info, pathstr, cmd);
+	if (path && *path != '/')
+		return (path);
+	return (hash_remember(bucket, cmd, path));
+}
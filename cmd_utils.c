@@ -12,6 +12,7 @@ int is_cmd(param_t *info, char *path)
 	struct stat st;
 
 	(void)info;
+	shell_stats[ST_STATS] += path != NULL;
 	if (!path || stat(path, &st))
 		return (0);
 
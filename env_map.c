@@ -0,0 +1,148 @@
+#include "shell.h"
+
+/*
+ * The environment is kept as its "name=value" strings in the order they
+ * were first set, which env and execve() see, and a table from the hash
+ * of each name to its string, so that a variable is found without
+ * looking at the others. Names are hashed and compared up to the '=',
+ * so "PATH", "PATH=" and "PATH=/bin" all name the same variable.
+ */
+
+/**
+ * env_same - Tells whether two strings name the same variable.
+ * @a: A name, or a "name=value" string.
+ * @b: Another.
+ *
+ * Return: 1 if they do, 0 if not.
+ */
+static int env_same(const char *a, const char *b)
+{
+	while (*a && *a != '=' && *a == *b)
+		a++, b++;
+	return ((!*a || *a == '=') && (!*b || *b == '='));
+}
+
+/**
+ * env_slot - Finds the slot of a variable in the environment.
+ * @m: The environment.
+ * @name: The name of the variable, the '=' and what follows ignored.
+ *
+ * Return: The slot holding it, or the free slot where it would go, see
+ *	struct env_map; NULL while the table is empty.
+ */
+long *env_slot(env_map_t *m, const char *name)
+{
+	size_t i;
+
+	if (!m || !m->slots)
+		return (NULL);
+	i = hash_str(name) & (m->slots - 1);
+	while (m->slot[i] && (m->slot[i] < 0
+				|| !env_same(m->var[m->slot[i] - 1], name)))
+		i = (i + 1) & (m->slots - 1);
+	return (&m->slot[i]);
+}
+
+/**
+ * env_rehash - Drops the holes of the environment and rebuilds its table.
+ * @m: The environment.
+ * @want: The variables to make room for, if more than are set.
+ *
+ * The table gets four times as many slots as variables, so that it
+ * stays at most half full until the next rebuild.
+ *
+ * Return: 0 on success, -1 on allocation failure.
+ */
+int env_rehash(env_map_t *m, size_t want)
+{
+	size_t n = 16, i, j;
+	long *old = m->slot;
+	char **var;
+
+	want = want > m->count ? want : m->count;
+	while (n < (want + 1) * 4)
+		n *= 2;
+	if (m->cap < want)
+	{
+		var = realloc(m->var, sizeof(char *) * want);
+		if (!var)
+			return (-1);
+		m->var = var, m->cap = want;
+	}
+	m->slot = malloc(sizeof(long) * n);
+	if (!m->slot)
+		return (m->slot = old, -1);
+	_memset((void *)m->slot, 0, sizeof(long) * n);
+	free(old);
+	m->slots = n;
+	for (i = 0, j = 0; i < m->len; i++)
+		if (m->var[i])
+		{
+			m->var[j++] = m->var[i];
+			*env_slot(m, m->var[i]) = j;
+		}
+	m->len = j;
+	return (0);
+}
+
+/**
+ * env_put - Sets a variable of the environment.
+ * @m: The environment.
+ * @str: The malloc'ed "name=value" string, which the environment then
+ *	owns, or NULL.
+ *
+ * A variable already set keeps its place. Holes left by removals count
+ * towards the load of the table, so they are dropped as it fills.
+ *
+ * Return: 0 on success, -1 on allocation failure.
+ */
+int env_put(env_map_t *m, char *str)
+{
+	size_t cap = m->cap ? m->cap * 2 : 64;
+	char **var;
+	long *s;
+
+	if (!str || ((m->len + 1) * 2 > m->slots && env_rehash(m, 0)))
+		return (free(str), -1);
+	s = env_slot(m, str);
+	if (*s > 0)
+	{
+		free(m->var[*s - 1]);
+		m->var[*s - 1] = str;
+		return (0);
+	}
+	if (m->len == m->cap)
+	{
+		var = realloc(m->var, sizeof(char *) * cap);
+		if (!var)
+			return (free(str), -1);
+		m->var = var, m->cap = cap;
+	}
+	m->var[m->len++] = str;
+	*s = m->len;
+	m->count++;
+	return (0);
+}
+
+/**
+ * env_del - Removes a variable from the environment.
+ * @m: The environment.
+ * @name: The name of the variable.
+ *
+ * Its slot is marked removed, so that lookups of the variables placed
+ * after it still find them, until the next rebuild.
+ *
+ * Return: 1 if it was set, 0 if not.
+ */
+int env_del(env_map_t *m, const char *name)
+{
+	long *s = env_slot(m, name);
+
+	if (!s || *s <= 0)
+		return (0);
+	free(m->var[*s - 1]);
+	m->var[*s - 1] = NULL;
+	*s = -1;
+	m->count--;
+	return (1);
+}
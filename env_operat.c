@@ -1,22 +1,56 @@
 #include "shell.h"
 
 /**
- * get_environ - Returns a copy of the string array 'environ'.
+ * get_environ - Returns the environment as a string array.
  * @info: Pointer to a structure containing potential arguments.
  *	Used to maintain constant function prototype.
- * Return: A pointer to the string array 'environ'.
+ *
+ * The array points at the strings of info->env, in order; it is only
+ * rebuilt after the environment changed.
+ *
+ * Return: A pointer to the string array, NULL on allocation failure.
  */
 char **get_environ(param_t *info)
 {
+	env_map_t *m = info->env;
+	size_t i, j = 0;
+
 	if (!info->environ || info->env_changed)
 	{
-		info->environ = list_to_strings(info->env);
+		free(info->environ);
+		info->environ = malloc(sizeof(char *) * (m ? m->count + 1 : 1));
+		if (!info->environ)
+			return (NULL);
+		for (i = 0; m && i < m->len; i++)
+			if (m->var[i])
+				info->environ[j++] = m->var[i];
+		info->environ[j] = NULL;
 		info->env_changed = 0;
+		shell_stats[ST_ENVIRON]++;
 	}
 
 	return (info->environ);
 }
 
+/**
+ * env_free - Frees the environment.
+ * @m: The environment, or NULL.
+ *
+ * Return: void.
+ */
+void env_free(env_map_t *m)
+{
+	size_t i;
+
+	if (!m)
+		return;
+	for (i = 0; i < m->len; i++)
+		free(m->var[i]);
+	free(m->var);
+	free(m->slot);
+	free(m);
+}
+
 /**
  * _unsetenv - Removes an environment variable.
  * @info: Pointer to a structure containing potential arguments.
@@ -26,26 +60,13 @@ char **get_environ(param_t *info)
  */
 int _unsetenv(param_t *info, char *var)
 {
-	list_t *node = info->env;
-	size_t i = 0;
-	char *p;
-
-	if (!node || !var)
+	if (!var || !env_del(info->env, var))
 		return (0);
-
-	while (node)
-	{
-		p = starts_with(node->str, var);
-		if (p && *p == '=')
-		{
-			info->env_changed = delete_node_at_index(&(info->env), i);
-			i = 0;
-			node = info->env;
-			continue;
-		}
-		node = node->next;
-		i++;
-	}
+	info->env_changed = 1;
+	if (!_strcmp(var, "PATH"))
+		hash_clear(info);
+	if (!_strcmp(var, "HISTSIZE") && info->hist)
+		info->hist->stale = 1;
 	return (info->env_changed);
 }
 
@@ -56,13 +77,11 @@ int _unsetenv(param_t *info, char *var)
  *	Used to maintain constant function prototype.
  * @var: The name of the environment variable.
  * @value: The value to be assigned to the environment variable.
- * Return: Always returns 0.
+ * Return: 0, 1 on allocation failure.
  */
 int _setenv(param_t *info, char *var, char *value)
 {
 	char *buf = NULL;
-	list_t *node;
-	char *p;
 
 	if (!var || !value)
 		return (0);
@@ -73,21 +92,14 @@ int _setenv(param_t *info, char *var, char *value)
 	_strcpy(buf, var);
 	_strcat(buf, "=");
 	_strcat(buf, value);
-	node = info->env;
-	while (node)
-	{
-		p = starts_with(node->str, var);
-		if (p && *p == '=')
-		{
-			free(node->str);
-			node->str = buf;
-			info->env_changed = 1;
-			return (0);
-		}
-		node = node->next;
-	}
-	add_node_end(&(info->env), buf, 0);
-	free(buf);
+	if (!_strcmp(var, "PATH"))
+		hash_clear(info);
+	if (!_strcmp(var, "HISTSIZE") && info->hist)
+		info->hist->stale = 1;
+	if (!info->env)
+		return (free(buf), 1);
+	if (env_put(info->env, buf))
+		return (1);
 	info->env_changed = 1;
 	return (0);
 }
@@ -0,0 +1,183 @@
+#include "shell.h"
+
+/**
+ * load_cmd - Makes a parsed command the current command.
+ * @info: Pointer to the parameter & return info struct.
+ * @cmd: The parsed command.
+ *
+ * The words are copied into info->argv, then aliases, variables and
+ * command substitutions are expanded as set_param() does for a typed
+ * line. The redirections
+ * are left in info->redir for redir_open().
+ *
+ * Return: void.
+ */
+void load_cmd(param_t *info, cmd_t *cmd)
+{
+	int i;
+
+	info->argv = malloc(sizeof(char *) * (cmd->argc + 1));
+	if (!info->argv)
+		return;
+	for (i = 0; i < cmd->argc; i++)
+		info->argv[i] = _strdup(cmd->argv[i]);
+	info->argv[i] = NULL;
+	info->argc = cmd->argc;
+	info->arg = cmd->argc ? cmd->argv[0] : NULL;
+	info->redir = cmd->redirs;
+	trace_event("expand", 'B', cmd->argc ? cmd->argv[0] : NULL);
+	if (info->argc)
+		replace_alias(info);
+	replace_vars(info);
+	trace_event("expand", 'E', NULL);
+}
+
+/**
+ * cmd_text - Rebuilds the text of a pipeline, for the job table.
+ * @cmd: The first command of the pipeline.
+ *
+ * Return: The malloc'ed text, or NULL on failure.
+ */
+char *cmd_text(cmd_t *cmd)
+{
+	strbuf_t sb = {NULL, 0, 0};
+	int i;
+
+	for (; cmd; cmd = cmd->op == PIPE_CMD ? cmd->next : NULL)
+	{
+		for (i = 0; i < cmd->argc; i++)
+		{
+			sb_append(&sb, cmd->argv[i], _strlen(cmd->argv[i]));
+			if (i + 1 < cmd->argc)
+				sb_append(&sb, " ", 1);
+		}
+		if (cmd->op == PIPE_CMD)
+			sb_append(&sb, " | ", 3);
+	}
+	return (sb.s);
+}
+
+/**
+ * run_one - Runs one pipeline of a parsed line.
+ * @info: Pointer to the parameter & return info struct.
+ * @cmd: The first command of the pipeline.
+ * @bg: If true the pipeline runs as a background job.
+ *
+ * A builtin runs in the shell, with its redirections applied around it
+ * and undone afterwards. A command made only of redirections just
+ * opens its files; one whose words all expanded to nothing keeps the
+ * status of its last command substitution.
+ *
+ * Return: The builtin return value, -2 if the shell must exit.
+ */
+static int run_one(param_t *info, cmd_t *cmd, int bg)
+{
+	int ret = 0;
+
+	if (bg || cmd->op == PIPE_CMD)
+		return (run_pipeline(info, cmd, bg), 0);
+	load_cmd(info, cmd);
+	if (!info->argv || redir_open(info))
+		return (free_param(info, 0), 0);
+	if (!info->argc)
+		info->status = cmd->argc ? info->status : 0;
+	else if (get_builtin(info->argv[0]))
+	{
+		ret = redir_apply(info, 1) ? 0 : find_builtin(info);
+		redir_restore(info);
+	}
+	else
+		find_cmd(info);
+	free_param(info, 0);
+	return (ret);
+}
+
+/**
+ * run_cmds - Runs a parsed line.
+ * @info: Pointer to the parameter & return info struct.
+ * @cmd: The first command of the line.
+ *
+ * A pipeline after && only runs if the status is 0 and one after ||
+ * only if it is not; a skipped pipeline leaves the status alone, so
+ * `false && a || b' runs b. A pipeline after the time keyword reports
+ * what it used on stderr once it is done.
+ *
+ * Return: -2 if a builtin asked the shell to exit, 0 otherwise.
+ */
+int run_cmds(param_t *info, cmd_t *cmd)
+{
+	int prev = NORMAL_CMD, ret = 0;
+	timing_t t;
+	cmd_t *end;
+
+	if (cmd && cmd->op == SYNTAX_CMD)
+	{
+		_eputs(info->fname);
+		_eputs(": ");
+		print_d(info->line_count, STDERR_FILENO);
+		_eputs(": Syntax error: \"");
+		_eputs(cmd->argv[0]);
+		_eputs("\" unexpected\n");
+		info->status = 2;
+		return (0);
+	}
+	for (; cmd && ret != -2; cmd = end->next)
+	{
+		end = cmd;
+		while (end->op == PIPE_CMD && end->next)
+			end = end->next;
+		if (!(prev == AND_CMD && info->status)
+				&& !(prev == OR_CMD && !info->status))
+		{
+			if (cmd->timed)
+				time_start(info, &t);
+			ret = run_one(info, cmd, end->op == BG_CMD);
+			if (cmd->timed)
+				time_report(info, cmd->timed, NULL);
+		}
+		prev = end->op;
+	}
+	return (ret == -2 ? -2 : 0);
+}
+
+/**
+ * run_text - Parses and runs a command line.
+ * @info: Pointer to the parameter & return info struct.
+ * @line: The command line.
+ *
+ * Parsing is purely syntactic, aliases and variables are expanded when
+ * each command runs, so the parsed form of a line is kept in the parse
+ * cache and reused when the same line comes again. Lines with
+ * here-documents are not cached, their bodies follow them in the input.
+ *
+ * Return: -2 if a builtin asked the shell to exit, 0 otherwise.
+ */
+int run_text(param_t *info, char *line)
+{
+	parse_ent_t *e = pc_lookup(info, line);
+	cmd_t *cmds = e ? e->cmds : NULL;
+	char *arg = info->arg;
+	int ret, lines = 0;
+
+	if (info->linecount_flag == 1)
+	{
+		info->line_count++;
+		info->linecount_flag = 0;
+	}
+	if (!e)
+	{
+		trace_event("parse", 'B', NULL);
+		cmds = parse_line(line);
+		trace_event("parse", 'E', NULL);
+		if (!heredoc_fill(info, cmds, NULL, &lines) && cmds)
+			e = pc_insert(info, line, cmds);
+	}
+	ret = run_cmds(info, cmds);
+	info->line_count += lines;
+	if (e)
+		pc_release(e);
+	else
+		free_cmds(cmds);
+	info->arg = arg;
+	return (ret);
+}
@@ -0,0 +1,170 @@
+#include "shell.h"
+
+/**
+ * field_end - Ends the field being built and adds it to a word list.
+ * @av: The word list, an array of char pointers.
+ * @cur: The field, its bytes are handed over to the list.
+ *
+ * Return: 0 on success, -1 on allocation failure.
+ */
+static int field_end(strbuf_t *av, strbuf_t *cur)
+{
+	char *f = cur->s ? cur->s : _strdup("");
+
+	cur->s = NULL;
+	cur->len = cur->cap = 0;
+	if (!f || sb_append(av, (char *)&f, sizeof(char *)))
+		return (free(f), -1);
+	return (0);
+}
+
+/**
+ * field_add - Adds text to the field being built, splitting it.
+ * @av: The word list the fields end up in.
+ * @cur: The field being built.
+ * @state: 0 if no field is open, 1 if one is, 2 if IFS blanks just
+ *	ended one.
+ * @s: The text.
+ * @ifs: The field separators, NULL to take the text as is.
+ *
+ * Separators that are blanks end a field and runs of them count as
+ * one; any other separator ends a field even when it is empty, and
+ * absorbs the blanks around it.
+ *
+ * Return: void.
+ */
+static void field_add(strbuf_t *av, strbuf_t *cur, int *state, char *s,
+		char *ifs)
+{
+	size_t n;
+
+	for (; *s; s++)
+	{
+		for (n = 0; s[n] && (!ifs || !_strchr(ifs, s[n])); n++)
+			;
+		if (n)
+		{
+			sb_append(cur, s, n);
+			*state = 1;
+			s += n - 1;
+			continue;
+		}
+		if (is_delim(*s, " \t\n"))
+		{
+			if (*state != 1)
+				continue;
+			*state = 2;
+		}
+		else if (*state == 2)
+		{
+			*state = 0;
+			continue;
+		}
+		else
+			*state = 0;
+		field_end(av, cur);
+	}
+}
+
+/**
+ * expand_fields - Expands the command substitutions of a word.
+ * @info: Pointer to the parameter & return info struct.
+ * @w: The word.
+ * @ifs: The field separators, NULL for no field splitting.
+ * @av: The word list the resulting fields are appended to.
+ *
+ * Only the output of the substitutions is split, the text around them
+ * is kept as written. A word that expands to nothing adds no field.
+ *
+ * Return: void.
+ */
+void expand_fields(param_t *info, char *w, char *ifs, strbuf_t *av)
+{
+	strbuf_t cur = {NULL, 0, 0}, out;
+	char *cmd;
+	size_t k, in;
+	int state = 0;
+
+	while (*w)
+	{
+		k = is_subst(w) ? subst_len(w, &in) : 0;
+		if (!k)
+		{
+			sb_append(&cur, w++, 1);
+			state = 1;
+			continue;
+		}
+		out.s = NULL, out.len = out.cap = 0;
+		cmd = malloc(in + 1);
+		if (cmd)
+			_strncpy(cmd, w + (*w == '$' ? 2 : 1), in + 1);
+		if (cmd && !subst_run(info, cmd, &out) && out.s)
+			field_add(av, &cur, &state, out.s, ifs);
+		free(cmd);
+		sb_free(&out);
+		w += k;
+	}
+	if (state == 1)
+		field_end(av, &cur);
+	sb_free(&cur);
+}
+
+/**
+ * expand_word - Expands a word that is not split into fields.
+ * @info: Pointer to the parameter & return info struct.
+ * @w: The word, as for a redirection or a here-string.
+ *
+ * Return: The malloc'ed expansion, or NULL on allocation failure.
+ */
+char *expand_word(param_t *info, char *w)
+{
+	strbuf_t av = {NULL, 0, 0};
+	char *s;
+
+	expand_fields(info, w, NULL, &av);
+	if (!av.len)
+		return (sb_free(&av), _strdup(""));
+	s = *(char **)av.s;
+	sb_free(&av);
+	return (s);
+}
+
+/**
+ * expand_args - Expands the words of the current command.
+ * @info: Pointer to the parameter & return info struct, argv is set.
+ *
+ * Words holding a command substitution are expanded and split on the
+ * characters of IFS, " \t\n" when it is unset; other words go through
+ * var_value(). The output of a command is not expanded again.
+ *
+ * Return: 0 on success, -1 on allocation failure.
+ */
+int expand_args(param_t *info)
+{
+	strbuf_t av = {NULL, 0, 0};
+	char *ifs = _getenv(info, "IFS="), *p;
+	int i;
+
+	for (i = 0; info->argv[i]; i++)
+	{
+		if (has_subst(info->argv[i]))
+		{
+			expand_fields(info, info->argv[i],
+					ifs ? ifs : " \t\n", &av);
+			free(info->argv[i]);
+			continue;
+		}
+		p = var_value(info, info->argv[i]);
+		if (p)
+			replace_string(&(info->argv[i]), p);
+		sb_append(&av, (char *)&(info->argv[i]), sizeof(char *));
+	}
+	p = NULL;
+	info->argv[0] = NULL;
+	if (sb_append(&av, (char *)&p, sizeof(char *)))
+		return (sb_free(&av), info->argc = 0, -1);
+	free(info->argv);
+	info->argv = (char **)av.s;
+	info->argc = av.len / sizeof(char *) - 1;
+	return (0);
+}
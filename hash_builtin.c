@@ -0,0 +1,93 @@
+#include "shell.h"
+
+/**
+ * print_hash - Lists the remembered command locations.
+ * @h: The command hash table, may be NULL.
+ *
+ * Return: The number of entries printed.
+ */
+size_t print_hash(cmd_hash_t *h)
+{
+	size_t count = 0;
+	list_t *node;
+	char *p;
+	int i;
+
+	for (i = 0; h && i < CMD_HASH_SIZE; i++)
+		for (node = h->bucket[i]; node; node = node->next)
+		{
+			p = _strchr(node->str, '=');
+			if (!p || !p[1])
+				continue;
+			if (!count++)
+				_puts("hits\tcommand\n");
+			_puts(convert_num_to_str(node->num, 10, 0));
+			_putchar('\t');
+			_puts(p + 1);
+			_putchar('\n');
+		}
+	if (!count)
+		_puts("hash: hash table empty\n");
+	return (count);
+}
+
+/**
+ * print_hash_stats - Prints the hit and miss counters of the hash table.
+ * @h: The command hash table, may be NULL.
+ *
+ * Return: Always 0.
+ */
+int print_hash_stats(cmd_hash_t *h)
+{
+	size_t entries = 0;
+	int i;
+
+	for (i = 0; h && i < CMD_HASH_SIZE; i++)
+		entries += list_len(h->bucket[i]);
+	_puts("hits=");
+	_puts(convert_num_to_str(h ? h->hits : 0, 10, CONVERT_UNSIGNED));
+	_puts(" misses=");
+	_puts(convert_num_to_str(h ? h->misses : 0, 10, CONVERT_UNSIGNED));
+	_puts(" entries=");
+	_puts(convert_num_to_str(entries, 10, CONVERT_UNSIGNED));
+	_putchar('\n');
+	return (0);
+}
+
+/**
+ * _hash - Mimics the hash builtin (man hash).
+ * @info: Structure containing potential arguments. Used to maintain
+ *        a constant function prototype.
+ *
+ * With no arguments the remembered locations are listed, -r forgets
+ * them, -s prints the hit and miss counters and any other argument is
+ * looked up in PATH and remembered.
+ *
+ * Return: 0 on success, 1 if a name could not be found.
+ */
+int _hash(param_t *info)
+{
+	int i, ret = 0;
+
+	if (info->argc == 1)
+	{
+		print_hash(info->cmdhash);
+		return (0);
+	}
+	for (i = 1; info->argv[i]; i++)
+	{
+		if (!_strcmp(info->argv[i], "-r"))
+			hash_clear(info);
+		else if (!_strcmp(info->argv[i], "-s"))
+			print_hash_stats(info->cmdhash);
+		else if (!hash_find(info, info->argv[i]))
+		{
+			_eputs(info->fname);
+			_eputs(": hash: ");
+			_eputs(info->argv[i]);
+			_eputs(": not found\n");
+			ret = 1;
+		}
+	}
+	return (ret);
+}
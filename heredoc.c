@@ -0,0 +1,119 @@
+#include "shell.h"
+
+/**
+ * next_line - Gets the next line of a here-document body.
+ * @info: Pointer to the parameter & return info struct.
+ * @text: Address of the rest of the script being compiled, or NULL to
+ *	read from the shell's input.
+ * @buf: Address of the line buffer used when reading the input.
+ *
+ * Lines of the input come from the same buffered reader as commands,
+ * so a body is read in the same pass as the line before it.
+ *
+ * Return: The line without its newline, or NULL at the end of input.
+ */
+static char *next_line(param_t *info, char **text, char **buf)
+{
+	char *line, *nl;
+	size_t len = 0;
+	ssize_t r;
+
+	if (text)
+	{
+		line = *text;
+		nl = line ? _strchr(line, '\n') : NULL;
+		if (nl)
+			*nl = 0;
+		*text = nl ? nl + 1 : NULL;
+		return (line && (nl || *line) ? line : NULL);
+	}
+	if (is_interactive(info))
+		_puts("> ");
+	_putchar(BUFFER_FLUSH);
+	free(*buf);
+	*buf = NULL;
+#if GETLINE
+	r = getline(buf, &len, stdin);
+#else
+	r = _getline(info, buf, &len);
+#endif
+	if (r <= 0)
+		return (NULL);
+	if ((*buf)[r - 1] == '\n')
+		(*buf)[r - 1] = '\0';
+	return (*buf);
+}
+
+/**
+ * read_body - Reads the body of a here-document.
+ * @info: Pointer to the parameter & return info struct.
+ * @r: The here-document; its word, the delimiter, is replaced by the
+ *	body.
+ * @text: Address of the rest of the script being compiled, or NULL to
+ *	read from the shell's input.
+ *
+ * Quotes and backslashes in the delimiter are removed. The body is
+ * taken as written, less the leading tabs of each line for <<-; if the
+ * delimiter was quoted it becomes REDIR_HEREDOC_RAW, which is never
+ * expanded.
+ *
+ * Return: The number of lines read, the delimiter included.
+ */
+static int read_body(param_t *info, redir_t *r, char **text)
+{
+	strbuf_t body = {NULL, 0, 0};
+	char *line, *buf = NULL, *d = r->word;
+	int n = 0, quoted;
+
+	for (line = r->word; *line; line++)
+		if (*line != '\'' && *line != '"' && *line != '\\')
+			*d++ = *line;
+	quoted = d != line;
+	*d = '\0';
+	while (1)
+	{
+		line = next_line(info, text, &buf);
+		if (!line)
+			break;
+		n++;
+		while (r->type == REDIR_HEREDOC_TABS && *line == '\t')
+			line++;
+		if (!_strcmp(line, r->word))
+			break;
+		sb_append(&body, line, _strlen(line));
+		sb_append(&body, "\n", 1);
+	}
+	free(buf);
+	free(r->word);
+	if (quoted)
+		r->type = REDIR_HEREDOC_RAW;
+	r->word = body.s ? body.s : _strdup("");
+	return (n);
+}
+
+/**
+ * heredoc_fill - Reads the bodies of the here-documents of a line.
+ * @info: Pointer to the parameter & return info struct.
+ * @cmds: The parsed line.
+ * @text: Address of the rest of the script being compiled, moved past
+ *	the bodies, or NULL to read them from the shell's input.
+ * @lines: Where to store the number of lines read.
+ *
+ * Return: The number of here-documents on the line.
+ */
+int heredoc_fill(param_t *info, cmd_t *cmds, char **text, int *lines)
+{
+	redir_t *r;
+	int n = 0;
+
+	*lines = 0;
+	for (; cmds; cmds = cmds->next)
+		for (r = cmds->redirs; r; r = r->next)
+			if (r->type == REDIR_HEREDOC
+					|| r->type == REDIR_HEREDOC_TABS)
+			{
+				*lines += read_body(info, r, text);
+				n++;
+			}
+	return (n);
+}
@@ -0,0 +1,122 @@
+#include "shell.h"
+
+/**
+ * var_len - Measures the variable reference at a position.
+ * @s: The position, at a '$'.
+ * @name: Where to store the offset of the name from @s.
+ * @nlen: Where to store the length of the name.
+ *
+ * Return: The length of the reference, 0 if the '$' is taken as is.
+ */
+static size_t var_len(char *s, size_t *name, size_t *nlen)
+{
+	size_t k;
+	int brace = s[1] == '{';
+
+	*name = 1 + brace;
+	k = *name;
+	if (s[k] == '?' || s[k] == '$' || s[k] == '!')
+		k++;
+	else if (_isalpha(s[k]) || s[k] == '_')
+		while (_isalpha(s[k]) || s[k] == '_'
+				|| (s[k] >= '0' && s[k] <= '9'))
+			k++;
+	*nlen = k - *name;
+	if (!*nlen || (brace && s[k] != '}'))
+		return (0);
+	return (k + brace);
+}
+
+/**
+ * put_var - Appends the value of a variable to a body being expanded.
+ * @info: Pointer to the parameter & return info struct.
+ * @name: The name of the variable.
+ * @len: Its length.
+ * @out: The expanded body.
+ *
+ * Return: void.
+ */
+static void put_var(param_t *info, char *name, size_t len, strbuf_t *out)
+{
+	char *w = malloc(len + 2), *v = NULL;
+
+	if (w)
+	{
+		w[0] = '$';
+		_strncpy(w + 1, name, len + 1);
+		v = var_value(info, w);
+	}
+	if (v)
+		sb_append(out, v, _strlen(v));
+	free(v);
+	free(w);
+}
+
+/**
+ * put_subst - Appends the output of a command substitution to a body
+ *	being expanded.
+ * @info: Pointer to the parameter & return info struct.
+ * @s: The substitution, where is_subst() is true.
+ * @out: The expanded body.
+ *
+ * Return: The length of the substitution.
+ */
+static size_t put_subst(param_t *info, char *s, strbuf_t *out)
+{
+	size_t k, in;
+	char *cmd;
+
+	k = subst_len(s, &in);
+	cmd = malloc(in + 1);
+	if (cmd)
+	{
+		_strncpy(cmd, s + (*s == '$' ? 2 : 1), in + 1);
+		subst_run(info, cmd, out);
+	}
+	free(cmd);
+	return (k);
+}
+
+/**
+ * heredoc_expand - Expands the body of a here-document.
+ * @info: Pointer to the parameter & return info struct.
+ * @body: The body, read after an unquoted delimiter.
+ *
+ * Variables and command substitutions are expanded, without field
+ * splitting. A backslash quotes a following '$', '`' or backslash and
+ * joins a line to the next; any other is kept.
+ *
+ * Return: @body itself if there is nothing to expand, else the
+ *	malloc'ed expansion, or NULL on allocation failure.
+ */
+char *heredoc_expand(param_t *info, char *body)
+{
+	strbuf_t out = {NULL, 0, 0};
+	size_t k, name, nlen;
+	char *s;
+
+	for (s = body; *s && *s != '$' && *s != '`' && *s != '\\'; s++)
+		;
+	if (!*s)
+		return (body);
+	for (s = body; *s; s += k)
+	{
+		k = *s == '$' ? var_len(s, &name, &nlen) : 0;
+		if (*s == '\\' && s[1] && _strchr("$`\\\n", s[1]))
+		{
+			if (s[1] != '\n')
+				sb_append(&out, s + 1, 1);
+			k = 2;
+		}
+		else if (is_subst(s))
+			k = put_subst(info, s, &out);
+		else if (k)
+			put_var(info, s + name, nlen, &out);
+		else
+		{
+			sb_append(&out, s, 1);
+			k = 1;
+		}
+	}
+	return (out.s ? out.s : _strdup(""));
+}
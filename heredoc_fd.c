@@ -0,0 +1,129 @@
+#include "shell.h"
+
+/**
+ * write_all - Writes a whole buffer to a fd.
+ * @fd: The file descriptor.
+ * @s: The buffer.
+ * @len: Its length.
+ *
+ * Return: 0 on success, -1 on error.
+ */
+static int write_all(int fd, char *s, size_t len)
+{
+	ssize_t w;
+
+	while (len)
+	{
+		w = write(fd, s, len);
+		if (w == -1 && errno == EINTR)
+			continue;
+		if (w == -1)
+			return (-1);
+		s += w;
+		len -= w;
+	}
+	return (0);
+}
+
+/**
+ * close_others - Closes every fd but one, in the writer of a pipe.
+ * @keep: The fd to keep open.
+ *
+ * Otherwise the writer would hold the shell's pipes and files open,
+ * and a reader waiting for the end of another pipe would hang until
+ * the body is read.
+ *
+ * Return: void.
+ */
+static void close_others(int keep)
+{
+	struct rlimit rl;
+	long fd, max = 1024;
+
+#ifdef CLOSE_RANGE_CLOEXEC
+	if ((keep == 0 || !close_range(0, keep - 1, 0))
+			&& !close_range(keep + 1, ~0U, 0))
+		return;
+#endif
+	if (!getrlimit(RLIMIT_NOFILE, &rl) && rl.rlim_cur != RLIM_INFINITY)
+		max = rl.rlim_cur;
+	for (fd = 0; fd < max; fd++)
+		if (fd != keep)
+			close(fd);
+}
+
+/**
+ * heredoc_pipe - Makes a pipe to read a here-document from.
+ * @body: The body.
+ * @len: Its length.
+ * @nl: If true a newline follows the body.
+ *
+ * The pipe is grown to hold the whole body when it can be; otherwise a
+ * detached grandchild writes it, so the shell never blocks on a reader
+ * that has not started yet.
+ *
+ * Return: The read end, or -1 on failure.
+ */
+static int heredoc_pipe(char *body, size_t len, int nl)
+{
+	int fds[2];
+	pid_t pid;
+
+	if (pipe2(fds, O_CLOEXEC) == -1)
+		return (-1);
+	if (fcntl(fds[1], F_GETPIPE_SZ) < (int)(len + nl))
+		fcntl(fds[1], F_SETPIPE_SZ, len + nl);
+	if (fcntl(fds[1], F_GETPIPE_SZ) >= (int)(len + nl))
+	{
+		write_all(fds[1], body, len);
+		if (nl)
+			write_all(fds[1], "\n", 1);
+		close(fds[1]);
+		return (fds[0]);
+	}
+	shell_stats[ST_FORKS]++;
+	pid = fork();
+	if (pid == 0 && fork() == 0)
+	{
+		close_others(fds[1]);
+		if (!write_all(fds[1], body, len) && nl)
+			write_all(fds[1], "\n", 1);
+	}
+	if (pid == 0)
+		_exit(0);
+	close(fds[1]);
+	if (pid == -1)
+		return (close(fds[0]), -1);
+	waitpid(pid, NULL, 0);
+	return (fds[0]);
+}
+
+/**
+ * heredoc_fd - Makes a fd to read a here-document or here-string from.
+ * @body: The body.
+ * @nl: If true a newline follows the body, as for a here-string.
+ *
+ * The body is written to a memfd, so no file is created and no writer
+ * has to wait for the reader; a pipe is used where memfd_create() is
+ * missing.
+ *
+ * Return: The fd, close-on-exec, or -1 on failure.
+ */
+int heredoc_fd(char *body, int nl)
+{
+	size_t len = _strlen(body);
+	int fd = -1;
+
+#ifdef MFD_CLOEXEC
+	fd = memfd_create("heredoc", MFD_CLOEXEC);
+#endif
+	if (fd == -1)
+		return (heredoc_pipe(body, len, nl));
+	if (write_all(fd, body, len) || (nl && write_all(fd, "\n", 1))
+			|| lseek(fd, 0, SEEK_SET) == -1)
+	{
+		close(fd);
+		return (-1);
+	}
+	return (fd);
+}
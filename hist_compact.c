@@ -0,0 +1,175 @@
+#include "shell.h"
+
+/**
+ * hist_tail - Finds the start of the last HISTSIZE entries of the
+ *	history file.
+ * @r: The ring.
+ * @map: The file, mapped.
+ * @size: Its size.
+ *
+ * The file is walked back from its end, so only the part kept is read.
+ *
+ * Return: The offset of the first entry kept.
+ */
+static long hist_tail(hist_ring_t *r, char *map, long size)
+{
+	long end = size, s;
+	size_t k = 0;
+
+	if (end && map[end - 1] == '\n')
+		end--;
+	while (end >= 0)
+	{
+		for (s = end; s > 0 && map[s - 1] != '\n'; s--)
+			;
+		if (!(end - s >= 3 && map[s] == '#' && map[s + 1] == 't'
+					&& map[s + 2] == ' ') && ++k == r->cap)
+			return (s);
+		if (!s)
+			break;
+		end = s - 1;
+	}
+	return (0);
+}
+
+/**
+ * hist_tmp - Writes the new version of a history file.
+ * @info: Pointer to the parameter struct.
+ * @suffix: Which file, see get_history_file().
+ * @data: Its contents.
+ * @len: Their size.
+ *
+ * It goes beside the file, with ".new" added to the name, until
+ * hist_put() moves it in place.
+ *
+ * Return: The new file, open, -1 on failure.
+ */
+static int hist_tmp(param_t *info, char *suffix, char *data, size_t len)
+{
+	char *path = get_history_file(info, suffix), *tmp = NULL;
+	int fd = -1;
+
+	if (path)
+		tmp = malloc(_strlen(path) + 5);
+	if (tmp)
+	{
+		_strcpy(tmp, path);
+		_strcat(tmp, ".new");
+		fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	}
+	if (fd != -1 && write(fd, data, len) != (ssize_t)len)
+		close(fd), fd = -1, unlink(tmp);
+	free(path);
+	free(tmp);
+	return (fd);
+}
+
+/**
+ * hist_put - Moves the new version of a history file in place.
+ * @info: Pointer to the parameter struct.
+ * @suffix: Which file, see get_history_file().
+ *
+ * Return: 0 on success, -1 on failure.
+ */
+static int hist_put(param_t *info, char *suffix)
+{
+	char *path = get_history_file(info, suffix), *tmp = NULL;
+	int ret = -1;
+
+	if (path)
+		tmp = malloc(_strlen(path) + 5);
+	if (tmp)
+	{
+		_strcpy(tmp, path);
+		_strcat(tmp, ".new");
+		ret = rename(tmp, path);
+		if (ret)
+			unlink(tmp);
+	}
+	free(path);
+	free(tmp);
+	return (ret);
+}
+
+/**
+ * hist_rewrite - Replaces the history file with its end, and its index.
+ * @info: Pointer to the parameter struct, with the file locked.
+ * @map: The file, mapped.
+ * @start: Where the part kept starts.
+ * @size: The size of the file.
+ *
+ * The offsets of the lines kept do not change: the origin moves by
+ * @start. The new file is locked before it is moved in place, and the
+ * index moved first, so that a shell that opens the new file finds
+ * the new index once it gets the lock.
+ *
+ * Return: 0 on success, -1 on failure.
+ */
+static int hist_rewrite(param_t *info, char *map, long start, long size)
+{
+	hist_ring_t *r = info->hist;
+	strbuf_t idx = {NULL, 0, 0};
+	long off = r->origin + start;
+	int fd, ifd, ret = -1;
+	char *p, *q;
+
+	sb_append(&idx, (char *)&off, sizeof(off));
+	for (p = map + start; p < map + size; p = q + 1)
+	{
+		q = memchr(p, '\n', map + size - p);
+		if (!q)
+			q = map + size;
+		off = r->origin + (p - map);
+		if (!(q - p >= 3 && p[0] == '#' && p[1] == 't' && p[2] == ' '))
+			sb_append(&idx, (char *)&off, sizeof(off));
+	}
+	fd = hist_tmp(info, "", map + start, size - start);
+	if (fd != -1 && !flock(fd, LOCK_EX) && idx.s)
+	{
+		ifd = hist_tmp(info, HIST_INDEX, idx.s, idx.len);
+		if (ifd != -1 && !close(ifd) && !hist_put(info, HIST_INDEX)
+				&& !hist_put(info, ""))
+			ret = 0;
+	}
+	if (fd != -1)
+		close(fd);
+	sb_free(&idx);
+	return (ret);
+}
+
+/**
+ * hist_compact - Compacts the history file if it grew too big.
+ * @info: Pointer to the parameter struct, with the history loaded.
+ *
+ * The file is rewritten with its last HISTSIZE entries, whichever
+ * shells appended them, once it passes HIST_COMPACT_MIN and twice the
+ * size of the entries kept here, or when its index must be rebuilt.
+ *
+ * Return: 1 if the file was rewritten, 0 if not, -1 on failure.
+ */
+int hist_compact(param_t *info)
+{
+	hist_ring_t *r = info->hist;
+	struct stat st;
+	char *map = NULL;
+	int ret = 0;
+
+	if (hist_lock(info))
+		return (-1);
+	if (fstat(r->fd, &st))
+		ret = -1;
+	else if (r->reindex || (st.st_size > HIST_COMPACT_MIN
+			&& (size_t)st.st_size > 2 * (r->used + 32 * r->count)))
+	{
+		if (st.st_size)
+			map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE,
+					r->fd, 0);
+		ret = map == MAP_FAILED || hist_rewrite(info, map,
+				map ? hist_tail(r, map, st.st_size) : 0,
+				st.st_size) ? -1 : 1;
+		if (map && map != MAP_FAILED)
+			munmap(map, st.st_size);
+	}
+	flock(r->fd, LOCK_UN);
+	return (ret);
+}
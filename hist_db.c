@@ -0,0 +1,115 @@
+#include "shell.h"
+
+/**
+ * hist_time_parse - Reads a timing line of the history file.
+ * @info: Pointer to the parameter struct.
+ * @line: The line, "#t start usec status cpu", not NUL-terminated.
+ * @len: Its length.
+ * @num: The history number of the entry it follows.
+ *
+ * Return: 1 if the line was a timing line, 0 otherwise.
+ */
+int hist_time_parse(param_t *info, char *line, size_t len, int num)
+{
+	char *end = line + len;
+	long v[4];
+	hist_time_t rec;
+	int i;
+
+	if (len < 3 || line[0] != '#' || line[1] != 't' || line[2] != ' ')
+		return (0);
+	for (line += 2, i = 0; i < 4; i++)
+	{
+		while (line < end && *line == ' ')
+			line++;
+		for (v[i] = 0; line < end && *line >= '0' && *line <= '9';
+				line++)
+			v[i] = v[i] * 10 + *line - '0';
+	}
+	rec.start = v[0];
+	rec.usec = v[1];
+	rec.status = v[2];
+	rec.cpu = v[3];
+	if (rec.start)
+		hist_time_set(info, num, &rec);
+	return (1);
+}
+
+/**
+ * hist_time_fmt - Formats the timing line of a history entry.
+ * @info: Pointer to the parameter struct.
+ * @num: The history number of the entry.
+ * @buf: Where to put the line, HIST_TIME_LEN bytes.
+ *
+ * Entries that were never timed get no line.
+ *
+ * Return: The length of the line, without a newline, 0 if there is none.
+ */
+size_t hist_time_fmt(param_t *info, int num, char *buf)
+{
+	hist_time_t *rec = hist_time_get(info, num);
+	long v[4];
+	size_t n = 2;
+	int i;
+
+	if (!rec)
+		return (0);
+	v[0] = rec->start, v[1] = rec->usec;
+	v[2] = rec->status, v[3] = rec->cpu;
+	_strcpy(buf, "#t");
+	for (i = 0; i < 4; i++)
+	{
+		buf[n++] = ' ';
+		_strcpy(buf + n, convert_num_to_str(v[i], 10, 0));
+		n += _strlen(buf + n);
+	}
+	return (n);
+}
+
+/**
+ * hist_new - Allocates an empty history.
+ *
+ * Return: The history, NULL on allocation failure.
+ */
+hist_ring_t *hist_new(void)
+{
+	hist_ring_t *r = malloc(sizeof(hist_ring_t));
+
+	if (!r)
+		return (NULL);
+	_memset((void *)r, 0, sizeof(hist_ring_t));
+	r->fd = -1;
+	r->idxfd = -1;
+	r->mark = -1;
+	return (r);
+}
+
+/**
+ * hist_load - Reads the history file the first time it is needed.
+ * @info: Pointer to the parameter struct.
+ *
+ * Startup does not read the history: the first line read from input,
+ * the history builtin or write_history() do, so a script that never
+ * looks at the history does not pay for it. The file is opened first
+ * and kept open to append each new entry to, see hist_append(). Later
+ * calls apply a new HISTSIZE, see hist_size().
+ *
+ * Return: The number of history entries.
+ */
+int hist_load(param_t *info)
+{
+	if (info->histload)
+	{
+		if (info->hist && info->hist->stale)
+			hist_size(info);
+		return (info->hist ? (int)info->hist->count : 0);
+	}
+	info->histload = 1;
+	info->hist = hist_new();
+	if (!info->hist)
+		return (0);
+	hist_size(info);
+	hist_open(info);
+	read_history(info);
+	return (info->histcount);
+}
@@ -0,0 +1,172 @@
+#include "shell.h"
+
+/*
+ * The history file is append-only and shared by all the shells of a
+ * user: each entry is written with one O_APPEND write when it is
+ * entered, followed by its "#t" timing line once it ran, under an
+ * flock() of the file. The index beside it, HISTORY_FILE HIST_INDEX,
+ * starts with the origin, then holds the offset of each entry, as
+ * native longs. Offsets count from the first byte ever written, so
+ * that they outlive compactions, which drop the start of the file and
+ * move the origin instead, see hist_compact.c; a shell that finds its
+ * file replaced by one opens the new one.
+ */
+
+/**
+ * hist_open - Opens the history file.
+ * @info: Pointer to the parameter struct, with the ring allocated.
+ *
+ * Files already open are closed first. The index is opened once the
+ * file is locked, see hist_lock().
+ *
+ * Return: void.
+ */
+void hist_open(param_t *info)
+{
+	hist_ring_t *r = info->hist;
+	char *path;
+
+	if (r->fd != -1)
+		close(r->fd);
+	if (r->idxfd != -1)
+		close(r->idxfd);
+	r->idxfd = -1;
+	path = r->cap ? get_history_file(info, "") : NULL;
+	r->fd = path ? open(path, O_RDWR | O_APPEND | O_CREAT | O_CLOEXEC,
+			0644) : -1;
+	free(path);
+}
+
+/**
+ * hist_open_index - Opens the index of the history file and reads its
+ *	origin.
+ * @info: Pointer to the parameter struct, with the file locked.
+ *
+ * A new index is started for an empty file. An index that cannot be
+ * used is left closed, and rebuilt when the file is compacted.
+ *
+ * Return: void.
+ */
+static void hist_open_index(param_t *info)
+{
+	hist_ring_t *r = info->hist;
+	char *path = get_history_file(info, HIST_INDEX);
+	struct stat st, hs;
+	long size = -1;
+
+	r->origin = 0;
+	r->idxfd = path ? open(path, O_RDWR | O_APPEND | O_CREAT | O_CLOEXEC,
+			0644) : -1;
+	free(path);
+	if (r->idxfd != -1 && !fstat(r->idxfd, &st) && !fstat(r->fd, &hs))
+		size = st.st_size;
+	if (!size && !hs.st_size && write(r->idxfd, &r->origin,
+				sizeof(long)) == sizeof(long))
+		size = sizeof(long);
+	if (size < (long)sizeof(long) || size % sizeof(long)
+			|| pread(r->idxfd, &r->origin, sizeof(long), 0)
+			!= sizeof(long))
+	{
+		if (r->idxfd != -1)
+			close(r->idxfd);
+		r->idxfd = -1, r->reindex = 1, r->origin = 0;
+	}
+}
+
+/**
+ * hist_lock - Locks the history file for this shell alone.
+ * @info: Pointer to the parameter struct.
+ *
+ * When the file was replaced by a compaction, the new one is opened
+ * and locked instead. flock(r->fd, LOCK_UN) unlocks it.
+ *
+ * Return: 0 with the file locked, -1 if there is none.
+ */
+int hist_lock(param_t *info)
+{
+	hist_ring_t *r = info->hist;
+	struct stat st;
+
+	while (r && r->fd != -1)
+	{
+		if (flock(r->fd, LOCK_EX))
+			return (-1);
+		if (fstat(r->fd, &st))
+			break;
+		if (st.st_nlink)
+		{
+			if (r->idxfd == -1 && !r->reindex)
+				hist_open_index(info);
+			return (0);
+		}
+		r->reindex = 0;
+		hist_open(info);
+	}
+	if (r && r->fd != -1)
+		flock(r->fd, LOCK_UN);
+	return (-1);
+}
+
+/**
+ * hist_own - Notes a line this shell appended to the history file.
+ * @r: The ring.
+ * @at: The offset of the line.
+ * @end: The offset past it.
+ *
+ * While nothing else was appended, the line just counts as read.
+ * Otherwise it is listed, for hist_read() to skip it.
+ *
+ * Return: void.
+ */
+static void hist_own(hist_ring_t *r, long at, long end)
+{
+	long pair[2], *own = (long *)r->own.s;
+	size_t n = r->own.len / sizeof(long);
+
+	if (r->seen == at)
+		r->seen = end;
+	else if (n && own[n - 1] == at)
+		own[n - 1] = end;
+	else
+	{
+		pair[0] = at, pair[1] = end;
+		sb_append(&r->own, (char *)pair, sizeof(pair));
+	}
+}
+
+/**
+ * hist_append - Appends a line to the history file.
+ * @info: Pointer to the parameter struct.
+ * @line: The line, without its newline.
+ * @len: Its length.
+ * @entry: 1 for an entry, whose offset goes to the index, 0 for the
+ *	timing line of the last one.
+ *
+ * The line and its newline go in one write under the lock. A timing
+ * line is dropped when another shell appended after the entry, as it
+ * must follow it.
+ *
+ * Return: void.
+ */
+void hist_append(param_t *info, char *line, size_t len, int entry)
+{
+	hist_ring_t *r = info->hist;
+	struct iovec v[2];
+	long at;
+
+	if (!r || !r->cap || hist_lock(info))
+		return;
+	at = r->origin + lseek(r->fd, 0, SEEK_END);
+	v[0].iov_base = line, v[0].iov_len = len;
+	v[1].iov_base = "\n", v[1].iov_len = 1;
+	if ((entry || at == r->mark)
+			&& writev(r->fd, v, 2) == (ssize_t)len + 1)
+	{
+		if (entry && r->idxfd != -1 && write(r->idxfd, &at,
+					sizeof(at)) != sizeof(at))
+			close(r->idxfd), r->idxfd = -1, r->reindex = 1;
+		hist_own(r, at, at + len + 1);
+		r->mark = at + len + 1;
+	}
+	flock(r->fd, LOCK_UN);
+}
@@ -0,0 +1,112 @@
+#include "shell.h"
+
+/**
+ * hist_gram_at - Finds the slot of a trigram in a table.
+ * @gram: The table, with a free slot.
+ * @n: Its size, a power of two.
+ * @key: The trigram.
+ *
+ * Slots are probed one after the other from the hash of the trigram.
+ *
+ * Return: The slot holding it, or the free slot where it would go.
+ */
+static hist_gram_t *hist_gram_at(hist_gram_t *gram, size_t n,
+		unsigned int key)
+{
+	unsigned int h = key * 2654435761u;
+	size_t i = (h ^ (h >> 15)) & (n - 1);
+
+	while (gram[i].key && gram[i].key != key)
+		i = (i + 1) & (n - 1);
+	return (&gram[i]);
+}
+
+/**
+ * hist_gram_grow - Doubles the trigram table of a search index.
+ * @f: The index.
+ *
+ * Return: 0 on success, -1 on allocation failure.
+ */
+static int hist_gram_grow(hist_find_t *f)
+{
+	size_t n = f->grams ? f->grams * 2 : 1024, i;
+	hist_gram_t *gram = malloc(sizeof(hist_gram_t) * n);
+
+	if (!gram)
+		return (-1);
+	_memset((void *)gram, 0, sizeof(hist_gram_t) * n);
+	for (i = 0; i < f->grams; i++)
+		if (f->gram[i].key)
+			*hist_gram_at(gram, n, f->gram[i].key) = f->gram[i];
+	free(f->gram);
+	f->gram = gram, f->grams = n;
+	return (0);
+}
+
+/**
+ * hist_gram_get - Gets the entries a trigram occurs in.
+ * @f: The search index.
+ * @key: The trigram, see struct hist_gram.
+ *
+ * Return: Its slot, NULL if no entry has it.
+ */
+hist_gram_t *hist_gram_get(hist_find_t *f, unsigned int key)
+{
+	hist_gram_t *g;
+
+	if (!f->grams)
+		return (NULL);
+	g = hist_gram_at(f->gram, f->grams, key);
+	return (g->key ? g : NULL);
+}
+
+/**
+ * hist_gram_add - Notes that a trigram occurs in an entry.
+ * @f: The search index.
+ * @key: The trigram, see struct hist_gram.
+ * @num: The history number of the entry, no lower than any before.
+ *
+ * The table is kept at most half full. An entry with the trigram more
+ * than once is only listed once.
+ *
+ * Return: 0 on success, -1 on allocation failure.
+ */
+int hist_gram_add(hist_find_t *f, unsigned int key, int num)
+{
+	hist_gram_t *g;
+	int *post;
+
+	if ((f->ngram + 1) * 2 > f->grams && hist_gram_grow(f))
+		return (-1);
+	g = hist_gram_at(f->gram, f->grams, key);
+	if (!g->key)
+		g->key = key, f->ngram++;
+	post = (int *)g->post.s;
+	if (g->post.len && post[g->post.len / sizeof(int) - 1] == num)
+		return (0);
+	if (sb_grow(&g->post, sizeof(num)))
+		return (-1);
+	*(int *)(g->post.s + g->post.len) = num;
+	g->post.len += sizeof(num);
+	return (0);
+}
+
+/**
+ * hist_find_free - Frees a search index.
+ * @f: The index, or NULL.
+ *
+ * Return: void.
+ */
+void hist_find_free(hist_find_t *f)
+{
+	size_t i;
+
+	if (!f)
+		return;
+	for (i = 0; i < f->grams; i++)
+		sb_free(&f->gram[i].post);
+	sb_free(&f->link);
+	free(f->gram);
+	free(f->node);
+	free(f);
+}
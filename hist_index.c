@@ -0,0 +1,121 @@
+#include "shell.h"
+
+/**
+ * hist_index_start - Finds where the entries worth loading start.
+ * @info: Pointer to the parameter struct, with the file locked.
+ * @map: The history file, mapped.
+ * @size: Its size, 0 if there is none.
+ * @count: Where to store the number of entries from there on, 0 if
+ *	unknown.
+ *
+ * The index gives the offset of the first of the last HISTSIZE entries
+ * without reading the others. An index that does not match the file is
+ * not used: the file is read whole and compacted at exit, which writes
+ * a new index.
+ *
+ * Return: The offset to read the file from.
+ */
+long hist_index_start(param_t *info, char *map, long size, long *count)
+{
+	hist_ring_t *r = info->hist;
+	long off[2] = {-1, -1}, n, first, i;
+	struct stat st;
+
+	*count = 0;
+	if (r->idxfd == -1 || fstat(r->idxfd, &st))
+		return (0);
+	n = st.st_size / sizeof(long) - 1;
+	first = n > (long)r->cap ? n - (long)r->cap : 0;
+	if (n > 0 && (pread(r->idxfd, &off[0], sizeof(long),
+				(first + 1) * sizeof(long)) != sizeof(long)
+			|| pread(r->idxfd, &off[1], sizeof(long),
+				n * sizeof(long)) != sizeof(long)))
+		n = -1;
+	if (!n && !size)
+		return (0);
+	for (i = 0; i < 2; i++)
+	{
+		off[i] -= r->origin;
+		if (n <= 0 || off[i] < 0 || off[i] >= size
+				|| (off[i] && map[off[i] - 1] != '\n'))
+		{
+			close(r->idxfd);
+			r->idxfd = -1;
+			return (r->reindex = 1, 0);
+		}
+	}
+	*count = n - first;
+	return (off[0]);
+}
+
+/**
+ * hist_read - Adds the entries of part of the history file.
+ * @info: Pointer to the parameter struct.
+ * @map: The history file, mapped.
+ * @from: Where to start, at the start of a line.
+ * @to: Where to stop, the size of the file.
+ *
+ * Lines this shell appended itself past what it had read are skipped,
+ * see hist_own(), and forgotten.
+ *
+ * Return: void.
+ */
+void hist_read(param_t *info, char *map, long from, long to)
+{
+	hist_ring_t *r = info->hist;
+	long *own = (long *)r->own.s, n = r->own.len / (2 * sizeof(long));
+	long k = 0, at;
+	char *p, *q;
+
+	for (p = map + from; from < to && p < map + to; p = q + 1)
+	{
+		q = memchr(p, '\n', map + to - p);
+		if (!q)
+			q = map + to;
+		at = r->origin + (p - map);
+		while (k < n && own[2 * k + 1] <= at)
+			k++;
+		if (k < n && own[2 * k] <= at)
+			continue;
+		if (!hist_time_parse(info, p, q - p, info->histcount - 1))
+			hist_add(info, p, q - p);
+	}
+	r->own.len = 0;
+}
+
+/**
+ * hist_pull - Adds the entries other shells appended since the last
+ *	read of the history file, for history -n.
+ * @info: Pointer to the parameter struct, with the history loaded.
+ *
+ * Only the bytes past the offset read up to are looked at.
+ *
+ * Return: 0 on success, -1 if there is no history file.
+ */
+int hist_pull(param_t *info)
+{
+	hist_ring_t *r = info->hist;
+	struct stat st;
+	char *map;
+	long from;
+
+	if (!r || hist_lock(info))
+		return (-1);
+	if (fstat(r->fd, &st))
+		st.st_size = 0;
+	from = r->seen - r->origin;
+	from = from < 0 ? 0 : from > st.st_size ? st.st_size : from;
+	if (from < st.st_size)
+	{
+		map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, r->fd, 0);
+		if (map != MAP_FAILED)
+		{
+			hist_read(info, map, from, st.st_size);
+			munmap(map, st.st_size);
+		}
+	}
+	r->seen = r->origin + st.st_size;
+	r->own.len = 0;
+	flock(r->fd, LOCK_UN);
+	return (0);
+}
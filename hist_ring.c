@@ -0,0 +1,116 @@
+#include "shell.h"
+
+/**
+ * hist_layout - Moves the history into new entry slots and a new arena.
+ * @r: The ring.
+ * @slots: The number of slots, at least r->count.
+ * @size: The size of the arena, more than r->used.
+ *
+ * Entries and lines are laid out from the start, oldest first. This is
+ * how the ring grows and shrinks; it doubles each time, so appending
+ * stays constant time on average.
+ *
+ * Return: 0 on success, -1 on allocation failure.
+ */
+int hist_layout(hist_ring_t *r, size_t slots, size_t size)
+{
+	hist_ent_t *ent = malloc(sizeof(hist_ent_t) * slots), *e;
+	char *arena = malloc(size);
+	size_t i, at = 0;
+
+	if (!ent || !arena)
+		return (free(ent), free(arena), -1);
+	for (i = 0; i < r->count; i++)
+	{
+		e = &r->ent[(r->first + i) % r->slots];
+		ent[i] = *e;
+		ent[i].off = at;
+		_strcpy(arena + at, r->arena + e->off);
+		at += e->len + 1;
+	}
+	free(r->ent);
+	free(r->arena);
+	r->ent = ent, r->slots = slots, r->first = 0;
+	r->arena = arena, r->size = size, r->tail = at;
+	return (0);
+}
+
+/**
+ * hist_evict - Drops the oldest history entry.
+ * @r: The ring, not empty.
+ *
+ * Its line is left in the arena, to be written over.
+ *
+ * Return: void.
+ */
+void hist_evict(hist_ring_t *r)
+{
+	r->used -= r->ent[r->first].len + 1;
+	r->first = (r->first + 1) % r->slots;
+	r->base++;
+	if (!--r->count)
+		r->first = 0, r->tail = 0;
+}
+
+/**
+ * hist_entry - Gets a history entry by its number.
+ * @info: Pointer to the parameter struct.
+ * @num: The history number of the entry.
+ *
+ * Return: The entry, or NULL if there is none by that number.
+ */
+hist_ent_t *hist_entry(param_t *info, int num)
+{
+	hist_ring_t *r = info->hist;
+
+	if (!r || num < r->base || (size_t)(num - r->base) >= r->count)
+		return (NULL);
+	return (&r->ent[(r->first + num - r->base) % r->slots]);
+}
+
+/**
+ * hist_size - Sets the number of entries the history keeps from HISTSIZE.
+ * @info: Pointer to the parameter struct, with the ring allocated.
+ *
+ * HISTORY_MAX is used when HISTSIZE is unset or not a number, and 0
+ * keeps no history. The oldest entries beyond the size are dropped,
+ * and the memory they held is given back.
+ *
+ * Return: The size.
+ */
+size_t hist_size(param_t *info)
+{
+	hist_ring_t *r = info->hist;
+	char *s = _getenv(info, "HISTSIZE=");
+	int n = s ? _erratoi(s) : -1;
+
+	r->cap = n < 0 ? HISTORY_MAX : (size_t)n;
+	r->stale = 0;
+	while (r->count > r->cap)
+		hist_evict(r);
+	info->histcount = r->base + r->count;
+	if (r->slots > r->cap * 2 && r->cap)
+		hist_layout(r, r->cap, r->used * 2 + 1);
+	return (r->cap);
+}
+
+/**
+ * hist_free - Frees the history and closes its files.
+ * @info: Pointer to the parameter struct.
+ *
+ * Return: void.
+ */
+void hist_free(param_t *info)
+{
+	if (!info->hist)
+		return;
+	if (info->hist->fd != -1)
+		close(info->hist->fd);
+	if (info->hist->idxfd != -1)
+		close(info->hist->idxfd);
+	free(info->hist->ent);
+	free(info->hist->arena);
+	sb_free(&info->hist->own);
+	hist_find_free(info->hist->find);
+	bfree((void **)&info->hist);
+}
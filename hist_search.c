@@ -0,0 +1,178 @@
+#include "shell.h"
+
+/*
+ * history -s searches the history through an index built the first time
+ * it runs: a trie of the first bytes of each entry for prefixes, and
+ * the entries each trigram occurs in for substrings. Each search first
+ * indexes the entries added since the last one, so the index costs
+ * nothing to a shell that never searches, and little per entry after.
+ * Entries dropped from the history stay listed until the index is
+ * rebuilt, once they outnumber the others; they are skipped meanwhile.
+ */
+
+/**
+ * num_cmp - Orders history numbers.
+ * @a: A number.
+ * @b: Another.
+ *
+ * Return: Less than, equal to or greater than 0, for qsort().
+ */
+static int num_cmp(const void *a, const void *b)
+{
+	int x = *(const int *)a, y = *(const int *)b;
+
+	return (x < y ? -1 : x > y);
+}
+
+/**
+ * hist_find_sync - Brings the search index up to date with the history.
+ * @info: Pointer to the parameter struct, with the history loaded.
+ *
+ * Return: The index, NULL on allocation failure.
+ */
+hist_find_t *hist_find_sync(param_t *info)
+{
+	hist_ring_t *r = info->hist;
+	hist_find_t *f = r->find;
+	unsigned char *s;
+	hist_ent_t *e;
+	size_t i;
+	int fail = 0;
+
+	if (f && r->base - f->start > (int)r->count + 1024)
+		hist_find_free(f), r->find = f = NULL;
+	if (!f)
+	{
+		r->find = f = malloc(sizeof(hist_find_t));
+		if (!f)
+			return (NULL);
+		_memset((void *)f, 0, sizeof(hist_find_t));
+		f->start = f->next = r->base;
+	}
+	for (f->next = f->next < r->base ? r->base : f->next;
+			!fail && f->next < r->base + (int)r->count; f->next++)
+	{
+		e = hist_entry(info, f->next);
+		s = (unsigned char *)r->arena + e->off;
+		for (i = 0; i + 2 < e->len && !fail; i++)
+			fail = hist_gram_add(f, ((unsigned int)s[i] << 16
+					| s[i + 1] << 8 | s[i + 2]) + 1,
+					f->next);
+		if (!fail)
+			fail = hist_trie_add(f, s, e->len, f->next);
+	}
+	if (fail)
+		hist_find_free(f), r->find = f = NULL;
+	return (f);
+}
+
+/**
+ * hist_cands - Lists the entries that may match a pattern.
+ * @info: Pointer to the parameter struct, with the history loaded.
+ * @pat: The pattern.
+ * @len: Its length.
+ * @prefix: 1 if entries must start with it, 0 if they must contain it.
+ * @out: The buffer to store their history numbers in, as ints, in
+ *	order.
+ *
+ * A prefix leads down the trie. For a substring, the entries of its
+ * rarest trigram are the candidates.
+ *
+ * Return: 0 with the candidates in @out, 1 if every entry is one.
+ */
+static int hist_cands(param_t *info, unsigned char *pat, size_t len,
+		int prefix, strbuf_t *out)
+{
+	hist_find_t *f = hist_find_sync(info);
+	hist_gram_t *g, *best = NULL;
+	size_t i;
+	int at;
+
+	if (!f || len < (prefix ? 1 : 3))
+		return (1);
+	if (prefix)
+	{
+		at = hist_trie_find(f, pat, len);
+		if (at < 0)
+			return (0);
+		if (hist_trie_collect(f, at, out))
+			return (out->len = 0, 1);
+		qsort(out->s, out->len / sizeof(int), sizeof(int), num_cmp);
+		return (0);
+	}
+	for (i = 0; i + 2 < len; i++)
+	{
+		g = hist_gram_get(f, ((unsigned int)pat[i] << 16
+					| pat[i + 1] << 8 | pat[i + 2]) + 1);
+		if (!g)
+			return (0);
+		if (!best || g->post.len < best->post.len)
+			best = g;
+	}
+	if (sb_append(out, best->post.s, best->post.len))
+		return (out->len = 0, 1);
+	return (0);
+}
+
+/**
+ * hist_match - Prints the history entries that match a pattern.
+ * @info: Pointer to the parameter struct, with the history loaded.
+ * @pat: The pattern, see hist_search().
+ *
+ * Return: The number of entries printed.
+ */
+static int hist_match(param_t *info, char *pat)
+{
+	hist_ring_t *r = info->hist;
+	strbuf_t cand = {NULL, 0, 0};
+	int prefix = *pat == '^', all, i, n, num, found = 0;
+	size_t len;
+	char *line;
+
+	pat += prefix;
+	len = _strlen(pat);
+	all = hist_cands(info, (unsigned char *)pat, len, prefix, &cand);
+	n = all ? (int)r->count : (int)(cand.len / sizeof(int));
+	for (i = 0; i < n; i++)
+	{
+		num = all ? r->base + i : ((int *)cand.s)[i];
+		if (num < r->base)
+			continue;
+		line = r->arena + hist_entry(info, num)->off;
+		if (prefix ? strncmp(line, pat, len) : !strstr(line, pat))
+			continue;
+		_puts(convert_num_to_str(num, 10, 0));
+		_puts(": ");
+		_puts(line);
+		_putchar('\n');
+		found++;
+	}
+	sb_free(&cand);
+	return (found);
+}
+
+/**
+ * hist_search - Prints the history entries that match a pattern, for
+ *	history -s.
+ * @info: Pointer to the parameter struct, with the history loaded.
+ * @av: The words of the pattern, joined by single spaces: a string the
+ *	entries contain, or with a leading '^', one they start with.
+ *
+ * Entries are printed as history prints them, oldest first.
+ *
+ * Return: The number of entries printed.
+ */
+int hist_search(param_t *info, char **av)
+{
+	strbuf_t pat = {NULL, 0, 0};
+	int i, found = 0;
+
+	for (i = 0; av[i]; i++)
+		if ((i && sb_append(&pat, " ", 1))
+				|| sb_append(&pat, av[i], _strlen(av[i])))
+			break;
+	if (info->hist && i && !av[i])
+		found = hist_match(info, pat.s);
+	sb_free(&pat);
+	return (found);
+}
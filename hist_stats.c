@@ -0,0 +1,126 @@
+#include "shell.h"
+
+/**
+ * name_cmp - Compares the command names of two history rows.
+ * @x: The first row.
+ * @y: The second row.
+ *
+ * Return: Less than, equal to or greater than 0 as for strcmp().
+ */
+static int name_cmp(const hist_row_t *x, const hist_row_t *y)
+{
+	int i;
+
+	for (i = 0; i < x->len && i < y->len; i++)
+		if (x->name[i] != y->name[i])
+			return ((unsigned char)x->name[i]
+					- (unsigned char)y->name[i]);
+	return (x->len - y->len);
+}
+
+/**
+ * row_cmp - Orders history rows by command name, then by duration.
+ * @a: The first row.
+ * @b: The second row.
+ *
+ * Return: Less than, equal to or greater than 0, for qsort().
+ */
+static int row_cmp(const void *a, const void *b)
+{
+	const hist_row_t *x = a, *y = b;
+	int c = name_cmp(x, y);
+
+	if (c)
+		return (c);
+	return (x->usec < y->usec ? -1 : x->usec > y->usec);
+}
+
+/**
+ * put_ms - Prints a tab and a duration in milliseconds.
+ * @usec: The duration in microseconds.
+ *
+ * Return: void.
+ */
+static void put_ms(long usec)
+{
+	_putchar('\t');
+	_puts(convert_num_to_str(usec / 1000, 10, 0));
+	_putchar('.');
+	_putchar('0' + usec / 100 % 10);
+	_putchar('0' + usec / 10 % 10);
+	_putchar('0' + usec % 10);
+	_puts("ms");
+}
+
+/**
+ * stat_row - Prints the statistics of one command name.
+ * @r: Its rows, sorted by duration.
+ * @n: The number of rows.
+ *
+ * Percentiles use the nearest rank: p is the duration of row
+ * ceil(p * n / 100).
+ *
+ * Return: void.
+ */
+static void stat_row(hist_row_t *r, int n)
+{
+	int pct[3], i, failed = 0;
+
+	pct[0] = 50, pct[1] = 95, pct[2] = 99;
+	for (i = 0; i < n; i++)
+		failed += r[i].status != 0;
+	_puts(convert_num_to_str(n, 10, 0));
+	_putchar('\t');
+	_puts(convert_num_to_str(failed, 10, 0));
+	for (i = 0; i < 3; i++)
+		put_ms(r[(pct[i] * n + 99) / 100 - 1].usec);
+	_putchar('\t');
+	for (i = 0; i < r->len; i++)
+		_putchar(r->name[i]);
+	_putchar('\n');
+}
+
+/**
+ * hist_stats - Prints latency percentiles of the timed history entries.
+ * @info: Pointer to the parameter struct.
+ *
+ * Entries are grouped by their first word, so the statistics follow a
+ * command across sessions as long as the history file keeps it.
+ *
+ * Return: 0 on success, 1 on allocation failure.
+ */
+int hist_stats(param_t *info)
+{
+	hist_ring_t *r = info->hist;
+	hist_row_t *rows = malloc(sizeof(hist_row_t)
+			* ((r ? r->count : 0) + 1));
+	hist_time_t *rec;
+	char *s;
+	int i, j, k, n = 0;
+
+	if (!rows)
+		return (1);
+	for (i = 0; r && (size_t)i < r->count; i++)
+	{
+		rec = hist_time_get(info, r->base + i);
+		s = r->arena + r->ent[(r->first + i) % r->slots].off;
+		for (; *s == ' ' || *s == '\t'; s++)
+			;
+		for (k = 0; s[k] && !is_delim(s[k], " \t;&|<>"); k++)
+			;
+		if (!rec || !k)
+			continue;
+		rows[n].name = s, rows[n].len = k;
+		rows[n].usec = rec->usec, rows[n++].status = rec->status;
+	}
+	qsort(rows, n, sizeof(hist_row_t), row_cmp);
+	_puts("count\tfailed\tp50\tp95\tp99\tcommand\n");
+	for (i = 0; i < n; i = j)
+	{
+		for (j = i + 1; j < n && !name_cmp(&rows[i], &rows[j]); j++)
+			;
+		stat_row(rows + i, j - i);
+	}
+	free(rows);
+	return (0);
+}
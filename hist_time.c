@@ -0,0 +1,73 @@
+#include "shell.h"
+
+/**
+ * hist_time_get - Gets the timing record of a history entry.
+ * @info: Pointer to the parameter struct.
+ * @num: The history number of the entry.
+ *
+ * Return: The record, or NULL if the entry was never timed.
+ */
+hist_time_t *hist_time_get(param_t *info, int num)
+{
+	hist_ent_t *e = hist_entry(info, num);
+
+	return (e && e->time.start ? &e->time : NULL);
+}
+
+/**
+ * hist_time_set - Stores the timing record of a history entry.
+ * @info: Pointer to the parameter struct.
+ * @num: The history number of the entry.
+ * @rec: The record, copied.
+ *
+ * The record lives in the entry, so it goes when the entry does.
+ *
+ * Return: 0 on success, -1 if there is no such entry.
+ */
+int hist_time_set(param_t *info, int num, hist_time_t *rec)
+{
+	hist_ent_t *e = hist_entry(info, num);
+
+	if (!e)
+		return (-1);
+	e->time = *rec;
+	return (0);
+}
+
+/**
+ * hist_run - Runs a line read from the input and times it.
+ * @info: Pointer to the parameter struct.
+ * @line: The line, the latest history entry.
+ *
+ * The start, duration, status and CPU time of the line are recorded
+ * next to its history entry, and appended to the history file. Under
+ * --profile the run is also charged to the line of the script. An empty
+ * line, which got no entry, is not recorded.
+ *
+ * Return: What run_text() returns.
+ */
+int hist_run(param_t *info, char *line)
+{
+	hist_time_t rec;
+	struct rusage ru;
+	unsigned int num = info->line_count + (info->linecount_flag == 1);
+	unsigned long mark[3];
+	char buf[HIST_TIME_LEN];
+	timing_t t;
+	int ret;
+
+	rec.start = time(NULL);
+	time_start(info, &t);
+	prof_mark(mark);
+	ret = run_text(info, line);
+	prof_command(line, mark);
+	rec.usec = time_report(info, 0, &ru);
+	rec.cpu = (ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) * 1000000L
+		+ ru.ru_utime.tv_usec + ru.ru_stime.tv_usec;
+	rec.status = info->status;
+	if (*line && !hist_time_set(info, info->histcount - 1, &rec))
+		hist_append(info, buf, hist_time_fmt(info, info->histcount - 1,
+					buf), 0);
+	lprof_add(info, num, &t, rec.usec);
+	return (ret);
+}
@@ -0,0 +1,138 @@
+#include "shell.h"
+
+/**
+ * hist_trie_node - Adds a node to the prefix trie of a search index.
+ * @f: The index.
+ * @parent: The node it hangs from, -1 for the root.
+ * @c: The byte that leads to it.
+ *
+ * Return: The new node, -1 on allocation failure.
+ */
+static int hist_trie_node(hist_find_t *f, int parent, unsigned char c)
+{
+	int cap = f->nodecap ? f->nodecap * 2 : 256;
+	hist_node_t *node, *n;
+
+	if (f->nodes == f->nodecap)
+	{
+		node = realloc(f->node, sizeof(hist_node_t) * cap);
+		if (!node)
+			return (-1);
+		f->node = node, f->nodecap = cap;
+	}
+	n = &f->node[f->nodes];
+	_memset((void *)n, 0, sizeof(hist_node_t));
+	n->c = c, n->first = -1, n->last = -1;
+	if (parent >= 0)
+	{
+		n->next = f->node[parent].child;
+		f->node[parent].child = f->nodes;
+	}
+	return (f->nodes++);
+}
+
+/**
+ * hist_trie_add - Adds an entry to the prefix trie of a search index.
+ * @f: The index.
+ * @s: The line of the entry.
+ * @len: Its length.
+ * @num: Its history number, no lower than any before.
+ *
+ * Only the first HIST_TRIE_DEPTH bytes get nodes; the entry is linked
+ * after the others at the node of the last of them. A child found is
+ * moved to the front of its siblings, so common prefixes are found in
+ * one step.
+ *
+ * Return: 0 on success, -1 on allocation failure.
+ */
+int hist_trie_add(hist_find_t *f, unsigned char *s, size_t len, int num)
+{
+	int at = 0, c, prev, none = -1, *link;
+	size_t i;
+
+	while (f->link.len / sizeof(int) <= (size_t)(num - f->start))
+		if (sb_append(&f->link, (char *)&none, sizeof(none)))
+			return (-1);
+	if (!f->nodes && hist_trie_node(f, -1, 0))
+		return (-1);
+	for (i = 0; i < len && i < HIST_TRIE_DEPTH; i++, at = c)
+	{
+		prev = 0;
+		for (c = f->node[at].child; c && f->node[c].c != s[i]; )
+			prev = c, c = f->node[c].next;
+		if (c && prev)
+		{
+			f->node[prev].next = f->node[c].next;
+			f->node[c].next = f->node[at].child;
+			f->node[at].child = c;
+		}
+		else if (!c)
+			c = hist_trie_node(f, at, s[i]);
+		if (c < 0)
+			return (-1);
+	}
+	link = (int *)f->link.s;
+	if (f->node[at].last >= 0)
+		link[f->node[at].last - f->start] = num;
+	else
+		f->node[at].first = num;
+	f->node[at].last = num;
+	return (0);
+}
+
+/**
+ * hist_trie_find - Finds the node of a prefix in the trie of a search
+ *	index.
+ * @f: The index.
+ * @s: The prefix.
+ * @len: Its length; only the first HIST_TRIE_DEPTH bytes are looked at.
+ *
+ * Return: The node, -1 if no entry starts with the prefix.
+ */
+int hist_trie_find(hist_find_t *f, unsigned char *s, size_t len)
+{
+	int at = 0;
+	size_t i;
+
+	if (!f->nodes)
+		return (-1);
+	for (i = 0; i < len && i < HIST_TRIE_DEPTH; i++)
+	{
+		for (at = f->node[at].child; at && f->node[at].c != s[i]; )
+			at = f->node[at].next;
+		if (!at)
+			return (-1);
+	}
+	return (at);
+}
+
+/**
+ * hist_trie_collect - Lists the entries under a node of the trie of a
+ *	search index.
+ * @f: The index.
+ * @at: The node.
+ * @out: The buffer to append their history numbers to, as ints, in no
+ *	particular order.
+ *
+ * Return: 0 on success, -1 on allocation failure.
+ */
+int hist_trie_collect(hist_find_t *f, int at, strbuf_t *out)
+{
+	strbuf_t stack = {NULL, 0, 0};
+	int ret = 0, c, num, *link = (int *)f->link.s;
+
+	while (!ret)
+	{
+		for (num = f->node[at].first; num >= 0 && !ret;
+				num = link[num - f->start])
+			ret = sb_append(out, (char *)&num, sizeof(num));
+		for (c = f->node[at].child; c && !ret; c = f->node[c].next)
+			ret = sb_append(&stack, (char *)&c, sizeof(c));
+		if (!stack.len)
+			break;
+		stack.len -= sizeof(int);
+		at = *(int *)(stack.s + stack.len);
+	}
+	sb_free(&stack);
+	return (ret);
+}
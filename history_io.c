@@ -3,144 +3,166 @@
 /**
  * get_history_file - Retrieves the history file path.
  * @info: Pointer to the parameter struct.
+ * @suffix: Appended to the path, "" for the history file itself.
  *
  * Return: Allocated string containing the history file path,
  *		or NULL on failure.
  */
-char *get_history_file(param_t *info)
+char *get_history_file(param_t *info, char *suffix)
 {
 	char *buf, *dir;
 
 	dir = _getenv(info, "HOME=");
 	if (!dir)
 		return (NULL);
-	buf = malloc(sizeof(char) * (_strlen(dir) + _strlen(HISTORY_FILE) + 2));
+	buf = malloc(sizeof(char) * (_strlen(dir) + _strlen(HISTORY_FILE)
+				+ _strlen(suffix) + 2));
 	if (!buf)
 		return (NULL);
 	buf[0] = 0;
 	_strcpy(buf, dir);
 	_strcat(buf, "/");
 	_strcat(buf, HISTORY_FILE);
+	_strcat(buf, suffix);
 	return (buf);
 }
 
 /**
- * write_history - Writes the history to a file.
+ * write_history - Compacts the history file at exit if it grew too big.
  * @info: Pointer to the parameter struct.
  *
- * Return: Returns 1 on success, else -1 on failure.
+ * Entries are appended to the file as they are entered, so there is
+ * usually nothing left to write, see hist_compact().
+ *
+ * Return: Returns 1 if the file was rewritten, 0 if there was nothing
+ *	to do, else -1 on failure.
  */
 int write_history(param_t *info)
 {
-	ssize_t fd;
-	char *filename = get_history_file(info);
-	list_t *node = NULL;
-
-	if (!filename)
-		return (-1);
+	hist_ring_t *r = info->hist;
 
-	fd = open(filename, O_CREAT | O_TRUNC | O_RDWR, 0644);
-	free(filename);
-	if (fd == -1)
-		return (-1);
-	for (node = info->history; node; node = node->next)
-	{
-		_putsfd(node->str, fd);
-		_putfd('\n', fd);
-	}
-	_putfd(BUFFER_FLUSH, fd);
-	close(fd);
-	return (1);
+	if (!info->histload || !r)
+		return (0);
+	hist_load(info);
+	if (!r->cap || r->fd == -1)
+		return (0);
+	return (hist_compact(info));
 }
 
 /**
  * read_history - Reads the history from a file.
- * @info: Pointer to the parameter struct.
+ * @info: Pointer to the parameter struct, with the file open.
+ *
+ * The file is mapped under its lock, and only the lines of the last
+ * HISTSIZE entries are copied into the history, see hist_index_start(),
+ * into a ring sized for them up front. A "#t" line after an entry holds
+ * its timing record, see hist_db.c. Entries are numbered from 0. Called
+ * once, through hist_load(); history -n reads what was appended since,
+ * see hist_pull().
  *
  * Return: Returns the number of history entries
  *	(histcount) on success, 0 otherwise.
  */
 int read_history(param_t *info)
 {
-	int i, last = 0, linecount = 0;
-	ssize_t fd, rdlen, fsize = 0;
+	hist_ring_t *r = info->hist;
+	char *map = MAP_FAILED;
 	struct stat st;
-	char *buf = NULL, *filename = get_history_file(info);
+	long n, start, size = 0;
 
-	if (!filename)
-		return (0);
-
-	fd = open(filename, O_RDONLY);
-	free(filename);
-	if (fd == -1)
-		return (0);
-	if (!fstat(fd, &st))
-		fsize = st.st_size;
-	if (fsize < 2)
+	if (hist_lock(info))
 		return (0);
-	buf = malloc(sizeof(char) * (fsize + 1));
-	if (!buf)
-		return (0);
-	rdlen = read(fd, buf, fsize);
-	buf[fsize] = 0;
-	if (rdlen <= 0)
-		return (free(buf), 0);
-	close(fd);
-	for (i = 0; i < fsize; i++)
-		if (buf[i] == '\n')
-		{
-			buf[i] = 0;
-			build_history_list(info, buf + last, linecount++);
-			last = i + 1;
-		}
-	if (last != i)
-		build_history_list(info, buf + last, linecount++);
-	free(buf);
-	info->histcount = linecount;
-	while (info->histcount-- >= HISTORY_MAX)
-		delete_node_at_index(&(info->history), 0);
-	renumber_history(info);
-	return (info->histcount);
+	if (!fstat(r->fd, &st))
+		size = st.st_size;
+	if (size)
+		map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, r->fd, 0);
+	if (map == MAP_FAILED)
+		map = NULL, size = 0;
+	start = hist_index_start(info, map, size, &n);
+	if (n)
+		hist_layout(r, n, size - start + 1);
+	if (size)
+		hist_read(info, map, start, size);
+	if (size)
+		munmap(map, size);
+	r->seen = r->origin + size;
+	flock(r->fd, LOCK_UN);
+	r->base = 0;
+	return (info->histcount = r->count);
 }
 
 /**
- * build_history_list - Adds an entry to the history linked list.
- * @info: Pointer to the parameter struct containing
- *	potential arguments. Used to maintain.
- * @buf: Buffer containing the history entry to be added.
- * @linecount: The history linecount, histcount.
+ * hist_place - Finds room for a line in the arena of the history.
+ * @r: The ring, with a free slot.
+ * @need: The bytes the line takes, with its NUL.
  *
- * Return: Always 0.
+ * The arena is a ring as well: a line goes after the newest one, or
+ * back at the start when the end is too short, as long as it stays
+ * clear of the oldest one. Failing that, the arena is laid out again
+ * twice as large.
+ *
+ * Return: The offset of the line, -1 on allocation failure.
  */
-int build_history_list(param_t *info, char *buf, int linecount)
+static long hist_place(hist_ring_t *r, size_t need)
 {
-	list_t *node = NULL;
-
-	if (info->history)
-		node = info->history;
-	add_node_end(&node, buf, linecount);
+	size_t start = r->count ? r->ent[r->first].off : 0, size;
 
-	if (!info->history)
-		info->history = node;
-	return (0);
+	if (r->count && r->tail <= start)
+	{
+		if (start - r->tail >= need)
+			return (r->tail);
+	}
+	else if (r->size - r->tail >= need)
+		return (r->tail);
+	else if (start >= need)
+		return (0);
+	for (size = r->size ? r->size * 2 : 256; size <= r->used + need; )
+		size *= 2;
+	if (hist_layout(r, r->slots, size))
+		return (-1);
+	return (r->tail);
 }
 
 /**
- * renumber_history - Renumbers the history linked list after changes.
- * @info: Pointer to the parameter struct containing
- *	potential arguments. Used to maintain.
+ * hist_add - Appends a line to the history.
+ * @info: Pointer to the parameter struct, with the history loaded.
+ * @line: The line, which need not be NUL-terminated.
+ * @len: Its length.
+ *
+ * Once HISTSIZE entries are kept, the oldest one is dropped to make
+ * room. Both take constant time, but for the rare layout of the ring
+ * into more room as it fills up.
  *
- * Return: Returns the new histcount.
+ * Return: 0 on success, -1 on allocation failure.
  */
-int renumber_history(param_t *info)
+int hist_add(param_t *info, char *line, size_t len)
 {
-	list_t *node = info->history;
-	int i = 0;
+	hist_ring_t *r = info->hist;
+	size_t slots, i;
+	hist_ent_t *e;
+	long off;
 
-	while (node)
+	if (!r || !r->cap)
+		return (0);
+	if (r->count == r->cap)
+		hist_evict(r);
+	if (r->count == r->slots)
 	{
-		node->num = i++;
-		node = node->next;
+		slots = r->slots ? r->slots * 2 : 16;
+		if (hist_layout(r, slots < r->cap ? slots : r->cap,
+					r->size ? r->size : 256))
+			return (-1);
 	}
-	return (info->histcount = i);
+	off = hist_place(r, len + 1);
+	if (off == -1)
+		return (-1);
+	e = &r->ent[(r->first + r->count++) % r->slots];
+	e->off = off, e->len = len;
+	_memset((void *)&e->time, 0, sizeof(e->time));
+	for (i = 0; i < len; i++)
+		r->arena[off + i] = line[i];
+	r->arena[off + len] = 0;
+	r->tail = off + len + 1, r->used += len + 1;
+	info->histcount = r->base + r->count;
+	return (0);
 }
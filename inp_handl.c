@@ -1,17 +1,20 @@
 #include "shell.h"
 
 /**
- * input_buf - Reads input and buffers chained commands.
+ * input_buf - Reads a line of input into a buffer.
  * @info: Parameter struct containing shell information.
  * @buf: Address of the buffer to store the input.
  * @len: Address of the length variable.
  *
+ * The line is added to the history without its comment, unless nothing
+ * is left of it.
+ *
  * Return: Number of bytes read.
  */
 ssize_t input_buf(param_t *info, char **buf, size_t *len)
 {
 	ssize_t r = 0;
-	size_t len_p = 0;
+	size_t len_p = 0, n;
 
 	if (!*len) /* If nothing left in the buffer, fill it. */
 	{
@@ -35,12 +38,15 @@ ssize_t input_buf(param_t *info, char **buf, size_t *len)
 			}
 			info->linecount_flag = 1;
 			del_comments(*buf);
-			build_history_list(info, *buf, info->histcount++);
-			/* if (_strchr(*buf, ';')) Is this a command chain? */
+			n = _strlen(*buf);
+			hist_load(info);
+			if (n)
 			{
-				*len = r;
-				info->cmd_buf = buf;
+				hist_add(info, *buf, n);
+				hist_append(info, *buf, n, 1);
 			}
+			*len = r;
+			info->cmd_buf = buf;
 		}
 	}
 	return (r);
@@ -50,45 +56,23 @@ ssize_t input_buf(param_t *info, char **buf, size_t *len)
  * get_input - Gets a line of input without the newline character.
  * @info: Parameter struct containing shell information.
  *
+ * The whole line is passed back in info->arg; splitting it into
+ * commands is left to parse_line().
+ *
  * Return: Number of bytes read.
  */
 ssize_t get_input(param_t *info)
 {
-	static char *buf; /* The ';' command chain buffer. */
-	static size_t i, j, len;
+	static char *buf; /* The input line buffer. */
+	size_t len = 0;
 	ssize_t r = 0;
-	char **buf_p = &(info->arg), *p;
 
 	_putchar(BUFFER_FLUSH);
 	r = input_buf(info, &buf, &len);
 	if (r == -1) /* EOF */
 		return (-1);
-	if (len) /* We have commands left in the chain buffer. */
-	{
-		j = i; /* Initialize new iterator to the current buf position. */
-		p = buf + i; /* Get pointer for return. */
-
-		check_chain(info, buf, &j, i, len);
-		while (j < len) /* Iterate to semicolon or end. */
-		{
-			if (is_chain(info, buf, &j))
-				break;
-			j++;
-		}
-
-		i = j + 1; /* Increment past nulled ';'' */
-		if (i >= len) /* Reached the end of the buffer? */
-		{
-			i = len = 0; /* Reset position and length. */
-			info->cmd_buf_type = NORMAL_CMD;
-		}
-
-		*buf_p = p; /* Pass back the pointer to the current command position. */
-		return (_strlen(p)); /* Return the length of the current command. */
-	}
-
-	*buf_p = buf; /* Else not a chain, pass back the buffer from _getline(). */
-	return (r); /* Return the length of the buffer from _getline(). */
+	info->arg = buf;
+	return (r);
 }
 
 /**
@@ -106,8 +90,11 @@ ssize_t read_buf(param_t *info, char *buf, size_t *i)
 	if (*i)
 		return (0);
 	r = read(info->readfd, buf, BUF_READ_SIZE);
+	shell_stats[ST_READS]++;
+	if (r >= 0)
+		*i = r, shell_stats[ST_READ_BYTES] += r;
 	if (r >= 0)
-		*i = r;
+		buf[r] = 0; /* _getline() looks for '\n' with _strchr(). */
 	return (r);
 }
 
@@ -121,37 +108,34 @@ ssize_t read_buf(param_t *info, char *buf, size_t *i)
  */
 int _getline(param_t *info, char **ptr, size_t *length)
 {
-	static char buf[BUF_READ_SIZE];
+	static char buf[BUF_READ_SIZE + 1];
 	static size_t i, len;
 	size_t k;
 	ssize_t r = 0, s = 0;
-	char *p = NULL, *new_p = NULL, *c;
+	char *p = NULL, *new_p = NULL, *c = NULL;
 
 	p = *ptr;
 	if (p && length)
 		s = *length;
-	if (i == len)
-		i = len = 0;
-
-	r = read_buf(info, buf, &len);
-	if (r == -1 || (r == 0 && len == 0))
+	while (!c) /* A line may span several reads. */
+	{
+		if (i == len)
+			i = len = 0;
+		r = read_buf(info, buf, &len);
+		if (r == -1 || (r == 0 && len == 0))
+			break;
+		c = _strchr(buf + i, '\n');
+		k = c ? 1 + (unsigned int)(c - buf) : len;
+		new_p = _realloc(p, s, s + k - i + 1);
+		if (!new_p) /* MALLOC FAILURE! */
+			return (p ? free(p), -1 : -1);
+		_strncpy(new_p + s, buf + i, k - i + 1);
+		s += k - i;
+		i = k;
+		p = new_p;
+	}
+	if (!s)
 		return (-1);
-
-	c = _strchr(buf + i, '\n');
-	k = c ? 1 + (unsigned int)(c - buf) : len;
-	new_p = _realloc(p, s, s ? s + k : k + 1);
-	if (!new_p) /* MALLOC FAILURE! */
-		return (p ? free(p), -1 : -1);
-
-	if (s)
-		_strncat(new_p, buf + i, k - i);
-	else
-		_strncpy(new_p, buf + i, k - i + 1);
-
-	s += k - i;
-	i = k;
-	p = new_p;
-
 	if (length)
 		*length = s;
 	*ptr = p;
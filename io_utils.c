@@ -31,9 +31,11 @@ int _eputchar(char c)
 	static int i;
 	static char buf[BUF_WRITE_SIZE];
 
-	if (c == BUFFER_FLUSH || i >= BUF_WRITE_SIZE)
+	if ((c == BUFFER_FLUSH || i >= BUF_WRITE_SIZE) && i)
 	{
 		write(2, buf, i);
+		shell_stats[ST_WRITES]++;
+		shell_stats[ST_WRITE_BYTES] += i;
 		i = 0;
 	}
 	if (c != BUFFER_FLUSH)
@@ -54,9 +56,11 @@ int _putfd(char c, int fd)
 	static int i;
 	static char buf[BUF_WRITE_SIZE];
 
-	if (c == BUFFER_FLUSH || i >= BUF_WRITE_SIZE)
+	if ((c == BUFFER_FLUSH || i >= BUF_WRITE_SIZE) && i)
 	{
 		write(fd, buf, i);
+		shell_stats[ST_WRITES]++;
+		shell_stats[ST_WRITE_BYTES] += i;
 		i = 0;
 	}
 	if (c != BUFFER_FLUSH)
@@ -0,0 +1,158 @@
+#include "shell.h"
+
+/**
+ * add_job - Adds a started background pipeline to the job table.
+ * @info: Pointer to the parameter & return info struct.
+ * @pids: The pids of the stages, -1 for stages that did not start.
+ * @n: The number of stages.
+ * @cmd: The malloc'ed command line, owned by the job from now on.
+ *
+ * Return: The new job, or NULL if no stage was started.
+ */
+job_t *add_job(param_t *info, pid_t *pids, int n, char *cmd)
+{
+	job_t *job, **tail = &(info->jobs);
+	int i, id = 0;
+
+	for (; *tail; tail = &((*tail)->next))
+		if ((*tail)->id > id)
+			id = (*tail)->id;
+	job = malloc(sizeof(job_t));
+	if (!job)
+		return (free(cmd), NULL);
+	_memset((void *)job, 0, sizeof(job_t));
+	for (i = 0; i < n; i++)
+		if (pids[i] != -1)
+			job->nprocs++, job->last = pids[i];
+	if (!job->nprocs)
+		return (free(cmd), free(job), NULL);
+	job->id = id + 1;
+	job->pgid = info->pgid;
+	job->cmd = cmd;
+	*tail = job;
+	info->last_bg = job->last;
+	if (is_interactive(info))
+	{
+		_eputchar('[');
+		_eputs(convert_num_to_str(job->id, 10, 0));
+		_eputs("] ");
+		_eputs(convert_num_to_str(job->last, 10, 0));
+		_eputchar('\n');
+	}
+	return (job);
+}
+
+/**
+ * get_job - Finds a job from a %id job spec or a pid.
+ * @info: Pointer to the parameter & return info struct.
+ * @spec: "%id", a pid of the job, or "%", "%%", "%+" or NULL for the
+ *	newest job.
+ *
+ * Return: The job, or NULL if there is no such job or @spec is not a
+ *	number.
+ */
+job_t *get_job(param_t *info, char *spec)
+{
+	job_t *job, *newest = NULL;
+	int cur = !spec || !_strcmp(spec, "%") || !_strcmp(spec, "%%")
+		|| !_strcmp(spec, "%+"), n = -1;
+
+	if (!cur)
+		n = _erratoi(spec + (*spec == '%'));
+	if (!cur && n == -1)
+		return (NULL);
+	for (job = info->jobs; job; job = job->next)
+	{
+		if (!cur && (*spec == '%' ? job->id == n
+					: (job->last == n || job->pgid == n)))
+			return (job);
+		newest = job;
+	}
+	return (cur ? newest : NULL);
+}
+
+/**
+ * update_job - Collects the state changes of a job's processes.
+ * @job: The job.
+ * @block: If true wait until the job is done or stopped.
+ *
+ * Return: The job's state.
+ */
+int update_job(job_t *job, int block)
+{
+	int st, flags = WUNTRACED | WCONTINUED | (block ? 0 : WNOHANG);
+	pid_t pid;
+
+	while (job->state != JOB_DONE)
+	{
+		pid = waitpid(-job->pgid, &st, flags);
+		if (pid == -1 && errno == EINTR)
+			continue;
+		if (pid == -1 && errno == ECHILD)
+			job->state = JOB_DONE;
+		if (pid <= 0)
+			break;
+		if (WIFSTOPPED(st) || WIFCONTINUED(st))
+		{
+			job->state = WIFSTOPPED(st) ? JOB_STOPPED : JOB_RUNNING;
+			if (block && job->state == JOB_STOPPED)
+				break;
+			continue;
+		}
+		if (pid == job->last)
+			job->status = WIFEXITED(st) ? WEXITSTATUS(st) : st;
+		if (--job->nprocs == 0)
+			job->state = JOB_DONE;
+	}
+	return (job->state);
+}
+
+/**
+ * reap_jobs - Collects finished background jobs without blocking.
+ * @info: Pointer to the parameter & return info struct.
+ *
+ * An interactive shell reports finished jobs and forgets them. A script
+ * keeps them so `wait $!' still finds the status, up to JOBS_DONE_MAX.
+ *
+ * Return: void.
+ */
+void reap_jobs(param_t *info)
+{
+	job_t *job, *next;
+	int done = 0;
+
+	for (job = info->jobs; job; job = job->next)
+		if (update_job(job, 0) == JOB_DONE)
+			done++;
+	for (job = info->jobs; job; job = next)
+	{
+		next = job->next;
+		if (job->state != JOB_DONE)
+			continue;
+		if (is_interactive(info))
+			print_job(job);
+		if (is_interactive(info) || done-- > JOBS_DONE_MAX)
+			remove_job(info, job);
+	}
+}
+
+/**
+ * remove_job - Removes a job from the job table and frees it.
+ * @info: Pointer to the parameter & return info struct.
+ * @job: The job to remove.
+ *
+ * Return: void.
+ */
+void remove_job(param_t *info, job_t *job)
+{
+	job_t **p;
+
+	for (p = &(info->jobs); *p; p = &((*p)->next))
+		if (*p == job)
+		{
+			*p = job->next;
+			free(job->cmd);
+			free(job);
+			return;
+		}
+}
@@ -0,0 +1,152 @@
+#include "shell.h"
+
+/**
+ * print_job - Prints a job the way the jobs builtin lists it.
+ * @job: The job to print.
+ *
+ * Return: void.
+ */
+void print_job(job_t *job)
+{
+	char *state[] = {"Running", "Stopped", "Done"};
+
+	_putchar('[');
+	_puts(convert_num_to_str(job->id, 10, 0));
+	_puts("]  ");
+	if (job->state == JOB_DONE && job->status)
+	{
+		_puts("Exit ");
+		_puts(convert_num_to_str(job->status, 10, 0));
+	}
+	else
+		_puts(state[job->state]);
+	_puts("\t\t");
+	_puts(job->cmd);
+	_putchar('\n');
+}
+
+/**
+ * _jobs - Lists the background jobs (man jobs).
+ * @info: Structure containing potential arguments. Used to maintain
+ *        a constant function prototype.
+ *
+ * Return: Always 0.
+ */
+int _jobs(param_t *info)
+{
+	job_t *job, *next;
+
+	for (job = info->jobs; job; job = next)
+	{
+		next = job->next;
+		update_job(job, 0);
+		print_job(job);
+		if (job->state == JOB_DONE)
+			remove_job(info, job);
+	}
+	return (0);
+}
+
+/**
+ * _fg - Brings a job to the foreground and waits for it (man fg).
+ * @info: Structure containing potential arguments. Used to maintain
+ *        a constant function prototype.
+ *
+ * The terminal is handed to the job's process group while it runs so
+ * ^C and ^Z reach the job instead of the shell.
+ *
+ * Return: The job's exit status, or 1 if there is no such job.
+ */
+int _fg(param_t *info)
+{
+	job_t *job = get_job(info, info->argv[1]);
+	int tty = is_interactive(info);
+	sigset_t set, old;
+
+	if (!job)
+		return (_perror(info, "no such job\n"), info->status = 1);
+	_puts(job->cmd), _putchar('\n'), _putchar(BUFFER_FLUSH);
+	sigemptyset(&set);
+	sigaddset(&set, SIGTTOU);
+	sigprocmask(SIG_BLOCK, &set, &old);
+	if (tty)
+		tcsetpgrp(STDIN_FILENO, job->pgid);
+	if (job->state == JOB_STOPPED)
+		kill(-job->pgid, SIGCONT), job->state = JOB_RUNNING;
+	update_job(job, 1);
+	if (tty)
+		tcsetpgrp(STDIN_FILENO, getpgrp());
+	sigprocmask(SIG_SETMASK, &old, NULL);
+	if (job->state == JOB_STOPPED)
+		return (print_job(job), info->status = 148);
+	info->status = job->status;
+	remove_job(info, job);
+	return (info->status);
+}
+
+/**
+ * _bg - Resumes a stopped job in the background (man bg).
+ * @info: Structure containing potential arguments. Used to maintain
+ *        a constant function prototype.
+ *
+ * Return: 0 on success, 1 if there is no such job.
+ */
+int _bg(param_t *info)
+{
+	job_t *job = get_job(info, info->argv[1]);
+
+	if (!job)
+		return (_perror(info, "no such job\n"), info->status = 1);
+	if (job->state == JOB_STOPPED)
+	{
+		kill(-job->pgid, SIGCONT);
+		job->state = JOB_RUNNING;
+	}
+	_putchar('[');
+	_puts(convert_num_to_str(job->id, 10, 0));
+	_puts("] ");
+	_puts(job->cmd);
+	_puts(" &\n");
+	return (info->status = 0);
+}
+
+/**
+ * _wait - Waits for background jobs to finish (man wait).
+ * @info: Structure containing potential arguments. Used to maintain
+ *        a constant function prototype.
+ *
+ * With no arguments every job is waited for and the status is 0;
+ * otherwise the status is the one of the last job or pid given, 127
+ * if it is unknown.
+ *
+ * Return: The exit status.
+ */
+int _wait(param_t *info)
+{
+	job_t *job;
+	int i;
+
+	info->status = 0;
+	if (info->argc == 1)
+		while (info->jobs)
+		{
+			update_job(info->jobs, 1);
+			remove_job(info, info->jobs);
+		}
+	for (i = 1; info->argv[i]; i++)
+	{
+		job = get_job(info, info->argv[i]);
+		if (!job)
+		{
+			_perror(info, info->argv[i]);
+			_eputs(": no such job\n");
+			info->status = 127;
+			continue;
+		}
+		while (update_job(job, 1) != JOB_DONE)
+			;
+		info->status = job->status;
+		remove_job(info, job);
+	}
+	return (info->status);
+}
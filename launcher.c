@@ -0,0 +1,213 @@
+#include "shell.h"
+
+#if USE_SPAWN
+/**
+ * spawn_attrs - Prepares the attributes shared by every spawned child.
+ * @attr: The spawn attributes to fill.
+ * @fa: The file actions to fill.
+ * @info: Pointer to the parameter & return info struct.
+ * @io: fds to become the child's stdin, stdout and stderr, -1 to
+ *	inherit one, or NULL to inherit all three.
+ *
+ * The child gets an empty signal mask and default dispositions for the
+ * signals the shell handles itself, then the command's redirections
+ * are applied after @io. Background children are put in the job's
+ * process group. Every fd the shell owns is close-on-exec.
+ *
+ * Return: 0 on success, an error number otherwise.
+ */
+static int spawn_attrs(posix_spawnattr_t *attr,
+		posix_spawn_file_actions_t *fa, param_t *info, int *io)
+{
+	redir_fd_t *f = info->redirfd;
+	sigset_t set;
+	int i, err;
+	short flags = POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSIGDEF;
+
+	sigemptyset(&set);
+	err = posix_spawnattr_setsigmask(attr, &set);
+	sigaddset(&set, SIGINT);
+	sigaddset(&set, SIGQUIT);
+	sigaddset(&set, SIGPIPE);
+	sigaddset(&set, SIGTTOU);
+	if (!err)
+		err = posix_spawnattr_setsigdefault(attr, &set);
+	if (!err && info->bg)
+	{
+		flags |= POSIX_SPAWN_SETPGROUP;
+		err = posix_spawnattr_setpgroup(attr, info->pgid);
+	}
+	if (!err)
+		err = posix_spawnattr_setflags(attr, flags);
+	for (i = 0; !err && io && i < 3; i++)
+		if (io[i] >= 0 && io[i] != i)
+			err = posix_spawn_file_actions_adddup2(fa, io[i], i);
+	for (; !err && f && f->fd != -1; f++)
+		if (f->src == -2)
+			err = posix_spawn_file_actions_addclose(fa, f->fd);
+		else if (f->src != f->fd)
+			err = posix_spawn_file_actions_adddup2(fa, f->src,
+					f->fd);
+	return (err);
+}
+
+/**
+ * launch_cmd - Starts info->path with info->argv in a new process.
+ * @info: Pointer to the parameter & return info struct.
+ * @io: fds to become the child's stdin, stdout and stderr, -1 to
+ *	inherit one, or NULL to inherit all three.
+ *
+ * posix_spawn() does not copy the shell's page tables, so the cost of
+ * starting a command no longer grows with the size of the shell.
+ *
+ * Return: The child's pid, or -1 with errno set on failure.
+ */
+pid_t launch_cmd(param_t *info, int *io)
+{
+	posix_spawnattr_t attr;
+	posix_spawn_file_actions_t fa;
+	pid_t pid = -1;
+	int err;
+
+	if (posix_spawnattr_init(&attr))
+		return (-1);
+	if (posix_spawn_file_actions_init(&fa))
+	{
+		posix_spawnattr_destroy(&attr);
+		return (-1);
+	}
+	err = spawn_attrs(&attr, &fa, info, io);
+	shell_stats[ST_SPAWNS] += !err;
+	if (!err)
+		err = posix_spawn(&pid, info->path, &fa, &attr, info->argv,
+				get_environ(info));
+	posix_spawn_file_actions_destroy(&fa);
+	posix_spawnattr_destroy(&attr);
+	if (err)
+	{
+		errno = err;
+		return (-1);
+	}
+	shell_stats[ST_EXECS]++;
+	if (info->bg)
+		setpgid(pid, info->pgid ? info->pgid : pid);
+	return (pid);
+}
+#else
+/**
+ * launch_cmd - Starts info->path with info->argv in a new process.
+ * @info: Pointer to the parameter & return info struct.
+ * @io: fds to become the child's stdin, stdout and stderr, -1 to
+ *	inherit one, or NULL to inherit all three.
+ *
+ * The child is set up as spawn_attrs() sets up a spawned one: an empty
+ * signal mask and default dispositions for SIGINT, SIGQUIT, SIGPIPE and
+ * SIGTTOU.
+ *
+ * Return: The child's pid, or -1 with errno set on failure.
+ */
+pid_t launch_cmd(param_t *info, int *io)
+{
+	pid_t child_pid;
+	sigset_t set;
+	int i;
+
+	shell_stats[ST_FORKS]++;
+	child_pid = fork();
+	shell_stats[ST_EXECS] += child_pid > 0;
+	if (child_pid > 0 && info->bg)
+		setpgid(child_pid, info->pgid ? info->pgid : child_pid);
+	if (child_pid != 0)
+		return (child_pid);
+	if (info->bg)
+		setpgid(0, info->pgid);
+	sigemptyset(&set);
+	sigprocmask(SIG_SETMASK, &set, NULL);
+	signal(SIGINT, SIG_DFL);
+	signal(SIGQUIT, SIG_DFL);
+	signal(SIGPIPE, SIG_DFL);
+	signal(SIGTTOU, SIG_DFL);
+	for (i = 0; io && i < 3; i++)
+		if (io[i] >= 0 && io[i] != i)
+			dup2(io[i], i);
+	if (redir_apply(info, 0))
+	{
+		_eputchar(BUFFER_FLUSH);
+		_exit(2);
+	}
+	if (execve(info->path, info->argv, get_environ(info)) == -1)
+	{
+		free_param(info, 1);
+		if (errno == EACCES)
+			exit(126);
+		if (errno == ENOENT)
+			exit(127);
+		exit(1);
+	}
+	return (-1);
+}
+#endif
+
+/**
+ * launch_error - Reports a command that could not be started.
+ * @info: Pointer to the parameter & return info struct.
+ * @err: The error number returned by launch_cmd().
+ *
+ * Return: void.
+ */
+void launch_error(param_t *info, int err)
+{
+	if (err == EACCES)
+	{
+		info->status = 126;
+		_perror(info, "Permission denied\n");
+	}
+	else if (err == ENOENT)
+	{
+		info->status = 127;
+		_perror(info, "not found\n");
+	}
+	else if (err == EBADF)
+	{
+		info->status = 2;
+		_perror(info, "Bad file descriptor\n");
+	}
+	else if (err == EAGAIN || err == ENOMEM)
+	{
+		info->status = 126;
+		perror("Error:");
+	}
+	else
+		info->status = 1;
+}
+
+/**
+ * wait_child - Waits for a child and stores its exit status.
+ * @info: Pointer to the parameter & return info struct.
+ * @pid: The child to wait for.
+ *
+ * The child's resource usage, and how long the shell was blocked on
+ * it, are added to the pipeline being timed.
+ *
+ * Return: 0 on success, -1 if the child could not be waited for.
+ */
+int wait_child(param_t *info, pid_t pid)
+{
+	struct rusage ru;
+	struct timespec since;
+	int status;
+
+	if (info->timing)
+		clock_gettime(CLOCK_MONOTONIC, &since);
+	trace_event("wait", 'B', NULL);
+	while (wait4(pid, &status, 0, &ru) == -1)
+		if (errno != EINTR)
+			return (trace_event("wait", 'E', NULL), -1);
+	trace_event("wait", 'E', NULL);
+	if (info->timing)
+		time_add(info->timing, &ru), lprof_wait(info->timing, &since);
+	info->status = status;
+	if (WIFEXITED(status))
+		info->status = WEXITSTATUS(status);
+	return (0);
+}
@@ -0,0 +1,146 @@
+#include "shell.h"
+
+/**
+ * lex_token - Reads the next word or operator of a line.
+ * @p: Address of the current position in the line, moved past the token.
+ * @op: Set to the operator read, REDIR_OP for a redirection, or to -1
+ *	for a word or the end of the line.
+ *
+ * The operators are ||, &&, |, & and ;, and the redirections [n]<,
+ * [n]>, [n]>>, [n]<&, [n]>&, [n]<<, [n]<<- and [n]<<<. They end a word
+ * even when no blank separates them from it; a redirection's fd is a
+ * single digit right before it, as in 2>&1. A command substitution is
+ * part of the word it is in, blanks and operators included.
+ *
+ * Return: The malloc'ed word or redirection, or NULL if an operator or
+ *	the end of the line was read.
+ */
+char *lex_token(char **p, int *op)
+{
+	char *s = *p, *word;
+	int k = 0;
+
+	while (is_delim(*s, " \t"))
+		s++;
+	*op = -1;
+	if (!*s)
+		return (*p = s, NULL);
+	if (is_delim(*s, ";&|"))
+	{
+		*op = *s == ';' ? CHAIN_CMD : *s == '&' ? BG_CMD : PIPE_CMD;
+		if (*s != ';' && s[1] == *s)
+			*op = *s++ == '&' ? AND_CMD : OR_CMD;
+		*p = s + 1;
+		return (NULL);
+	}
+	if (*s >= '0' && *s <= '9' && is_delim(s[1], "<>"))
+		k = 1;
+	if (is_delim(s[k], "<>"))
+	{
+		*op = REDIR_OP;
+		if (s[k] == '<' && s[k + 1] == '<')
+			k += 2 + (s[k + 2] == '<' || s[k + 2] == '-');
+		else
+			k += 1 + (s[k + 1] == '&'
+					|| (s[k] == '>' && s[k + 1] == '>'));
+	}
+	else
+		while (s[k] && !is_delim(s[k], " \t;&|<>"))
+			k += is_subst(s + k) ? subst_len(s + k, NULL) : 1;
+	word = malloc(k + 1);
+	if (word)
+		_strncpy(word, s, k + 1);
+	*p = s + k;
+	return (word);
+}
+
+/**
+ * new_redir - Builds a redirection from its operator and word.
+ * @op: The operator as read by lex_token(), freed.
+ * @word: The file name or fd that follows it, taken over.
+ *
+ * Return: The redirection, or NULL on allocation failure.
+ */
+redir_t *new_redir(char *op, char *word)
+{
+	redir_t *r = malloc(sizeof(redir_t));
+	char *s = op;
+
+	if (!r)
+		return (free(op), free(word), NULL);
+	r->fd = *s == '<' ? 0 : 1;
+	if (*s >= '0' && *s <= '9')
+		r->fd = *s++ - '0';
+	r->type = *s == '<' ? REDIR_IN : REDIR_OUT;
+	if (s[1] == '>')
+		r->type = REDIR_APPEND;
+	else if (s[1] == '&')
+		r->type = REDIR_DUP;
+	else if (s[1] == '<')
+		r->type = s[2] == '<' ? REDIR_HERESTR : s[2] == '-'
+			? REDIR_HEREDOC_TABS : REDIR_HEREDOC;
+	r->word = word;
+	r->next = NULL;
+	free(op);
+	return (r);
+}
+
+/**
+ * free_redirs - Frees a list of redirections.
+ * @r: The first redirection.
+ *
+ * Return: void.
+ */
+void free_redirs(redir_t *r)
+{
+	redir_t *next;
+
+	for (; r; r = next)
+	{
+		next = r->next;
+		free(r->word);
+		free(r);
+	}
+}
+
+/**
+ * op_name - Gets the text of an operator, for error messages.
+ * @op: The operator, or -1 for the end of the line.
+ *
+ * Return: The text of the operator.
+ */
+char *op_name(int op)
+{
+	char *names[] = {"newline", "||", "&&", ";", "|", "&"};
+
+	return (names[op > 0 && op <= BG_CMD ? op : 0]);
+}
+
+/**
+ * time_word - Reads the time keyword and its -p or -v option.
+ * @w: A word at the start of a pipeline, before its command.
+ * @timed: The TIME_ value of the pipeline so far, updated.
+ *
+ * Usage: time [-p | -v] pipeline. The report goes to stderr once the
+ * pipeline ends. Without an option it gives the real, user and sys
+ * times as "0m1.234s" followed by the peak RSS, page faults and context
+ * switches; -p gives only "real", "user" and "sys" lines in seconds, as
+ * POSIX requires; -v gives those lines followed by "maxrss", "minflt",
+ * "majflt", "nvcsw" and "nivcsw" lines, one "key value" pair each.
+ *
+ * Return: 1 if the word belongs to the keyword and was freed, 0 if it
+ *	is the command's.
+ */
+int time_word(char *w, int *timed)
+{
+	if (!*timed && !_strcmp(w, "time"))
+		*timed = TIME_HUMAN;
+	else if (*timed == TIME_HUMAN && !_strcmp(w, "-p"))
+		*timed = TIME_POSIX;
+	else if (*timed == TIME_HUMAN && !_strcmp(w, "-v"))
+		*timed = TIME_KEYS;
+	else
+		return (0);
+	free(w);
+	return (1);
+}
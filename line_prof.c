@@ -0,0 +1,71 @@
+#include "shell.h"
+
+/**
+ * lprof_wait - Counts time the shell spent blocked on children.
+ * @t: The innermost timing.
+ * @since: When the shell started waiting, on the monotonic clock.
+ *
+ * Return: void.
+ */
+void lprof_wait(timing_t *t, struct timespec *since)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	t->waited += (now.tv_sec - since->tv_sec) * 1000000L
+		+ (now.tv_nsec - since->tv_nsec) / 1000;
+}
+
+/**
+ * lprof_add - Records a run of a script line being profiled.
+ * @info: Pointer to the parameter & return info struct.
+ * @line: The line number.
+ * @t: The timing the line ran under, ended already.
+ * @usec: The wall clock time the line took, in microseconds.
+ *
+ * Nothing is recorded unless the shell runs with --profile.
+ *
+ * Return: void.
+ */
+void lprof_add(param_t *info, unsigned int line, timing_t *t, long usec)
+{
+	strbuf_t *sb = &info->lineprof;
+	size_t at = (size_t)line * sizeof(line_prof_t);
+	line_prof_t *rec;
+
+	if (!info->profile)
+		return;
+	if (at >= sb->len)
+	{
+		if (sb_grow(sb, at + sizeof(line_prof_t) - sb->len))
+			return;
+		_memset(sb->s + sb->len, 0, at + sizeof(line_prof_t) - sb->len);
+		sb->len = at + sizeof(line_prof_t);
+	}
+	rec = (line_prof_t *)sb->s + line;
+	rec->line = line;
+	rec->count++;
+	rec->total += usec;
+	rec->self += usec > t->waited ? usec - t->waited : 0;
+}
+
+/**
+ * lprof_run - Runs a line of a compiled script, profiling it if asked.
+ * @info: Pointer to the parameter & return info struct.
+ * @cmds: The parsed line.
+ * @line: Its line number.
+ *
+ * Return: What run_cmds() returns.
+ */
+int lprof_run(param_t *info, cmd_t *cmds, unsigned int line)
+{
+	timing_t t;
+	int ret;
+
+	if (!info->profile)
+		return (run_cmds(info, cmds));
+	time_start(info, &t);
+	ret = run_cmds(info, cmds);
+	lprof_add(info, line, &t, time_report(info, 0, NULL));
+	return (ret);
+}
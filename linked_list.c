@@ -1,5 +1,8 @@
 #include "shell.h"
 
+/* the functions, not the tagging macros of shell.h */
+#undef list_to_strings
+
 /**
  * list_len - Calculates the length of a linked list.
  * @h: Pointer to the first node of the linked list.
@@ -1,5 +1,9 @@
 #include "shell.h"
 
+/* the functions, not the tagging macros of shell.h */
+#undef add_node
+#undef add_node_end
+
 /**
  * add_node - Adds a new node to the beginning of the list.
  * @head: Address of the pointer to the head node.
@@ -17,6 +21,7 @@ list_t *add_node(list_t **head, const char *str, int num)
 	new_head = malloc(sizeof(list_t));
 	if (!new_head)
 		return (NULL);
+	shell_stats[ST_LIST_NODES]++;
 	_memset((void *)new_head, 0, sizeof(list_t));
 	new_head->num = num;
 	if (str)
@@ -52,6 +57,7 @@ list_t *add_node_end(list_t **head, const char *str, int num)
 	new_node = malloc(sizeof(list_t));
 	if (!new_node)
 		return (NULL);
+	shell_stats[ST_LIST_NODES]++;
 	_memset((void *)new_node, 0, sizeof(list_t));
 	new_node->num = num;
 	if (str)
@@ -0,0 +1,111 @@
+#include "shell.h"
+
+/**
+ * line_cmp - Orders profiled lines, the slowest first.
+ * @a: The first line.
+ * @b: The second line.
+ *
+ * Lines that took as long stay in script order.
+ *
+ * Return: Less than, equal to or greater than 0, for qsort().
+ */
+static int line_cmp(const void *a, const void *b)
+{
+	const line_prof_t *x = a, *y = b;
+
+	if (x->total != y->total)
+		return (x->total < y->total ? 1 : -1);
+	return (x->line < y->line ? -1 : x->line > y->line);
+}
+
+/**
+ * put_ms - Prints a tab and a duration in milliseconds to stderr.
+ * @usec: The duration in microseconds.
+ *
+ * Return: void.
+ */
+static void put_ms(long usec)
+{
+	_eputchar('\t');
+	_eputs(convert_num_to_str(usec / 1000, 10, 0));
+	_eputchar('.');
+	_eputchar('0' + usec / 100 % 10);
+	_eputchar('0' + usec / 10 % 10);
+	_eputchar('0' + usec % 10);
+}
+
+/**
+ * script_lines - Reads the profiled script and finds its lines.
+ * @info: Pointer to the parameter & return info struct.
+ * @text: The buffer to read the script into.
+ * @lines: Where to put a pointer to each line, by number from 1.
+ *
+ * Return: The number of lines, 0 if the script cannot be read.
+ */
+static size_t script_lines(param_t *info, strbuf_t *text, strbuf_t *lines)
+{
+	char *s = NULL, *nl;
+	ssize_t r;
+	int fd = open(info->profile, O_RDONLY | O_CLOEXEC);
+
+	if (fd == -1)
+		return (0);
+	do {
+		r = sb_read_fd(text, fd);
+	} while (r > 0);
+	close(fd);
+	if (r == -1 || !text->s || sb_append(lines, (char *)&s, sizeof(s)))
+		return (0);
+	for (s = text->s; s; s = nl ? nl + 1 : NULL)
+	{
+		if (sb_append(lines, (char *)&s, sizeof(s)))
+			return (0);
+		nl = _strchr(s, '\n');
+		if (nl)
+			*nl = '\0';
+	}
+	return (lines->len / sizeof(s) - 1);
+}
+
+/**
+ * lprof_report - Prints the --profile report of the script to stderr.
+ * @info: Pointer to the parameter & return info struct.
+ *
+ * Every line that ran gets its run count and the milliseconds it took,
+ * in total and in the shell itself, not waiting for the commands it
+ * started; the slowest lines come first.
+ *
+ * Return: void.
+ */
+void lprof_report(param_t *info)
+{
+	strbuf_t text = {NULL, 0, 0}, lines = {NULL, 0, 0};
+	line_prof_t *rec = (line_prof_t *)info->lineprof.s;
+	size_t i, n = 0, nlines;
+
+	if (!info->profile)
+		return;
+	nlines = script_lines(info, &text, &lines);
+	for (i = 0; i < info->lineprof.len / sizeof(*rec); i++)
+		if (rec[i].count)
+			rec[n++] = rec[i];
+	qsort(rec, n, sizeof(*rec), line_cmp);
+	_putchar(BUFFER_FLUSH);
+	_eputs("line\tcount\ttotal_ms\tself_ms\tcommand\n");
+	for (i = 0; i < n; i++)
+	{
+		_eputs(convert_num_to_str(rec[i].line, 10, 0));
+		_eputchar('\t');
+		_eputs(convert_num_to_str(rec[i].count, 10, CONVERT_UNSIGNED));
+		put_ms(rec[i].total);
+		put_ms(rec[i].self);
+		_eputchar('\t');
+		if (rec[i].line <= nlines)
+			_eputs(((char **)lines.s)[rec[i].line]);
+		_eputchar('\n');
+	}
+	_eputchar(BUFFER_FLUSH);
+	info->lineprof.len = 0;
+	sb_free(&text);
+	sb_free(&lines);
+}
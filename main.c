@@ -5,6 +5,12 @@
  * @ac: arg count
  * @av: arg vector
  *
+ * `hsh --profile script' runs the script and then prints how long each
+ * of its lines took, see lprof_report().
+ *
+ * The history file is only read once something needs it, see
+ * hist_load(), so scripts start without it.
+ *
  * Return: 0 on success, 1 on error
  */
 int main(int ac, char **av)
@@ -17,9 +23,11 @@ int main(int ac, char **av)
 			: "=r" (fd)
 			: "r" (fd));
 
+	if (ac == 3 && !_strcmp(av[1], "--profile"))
+		info->profile = av[2], av[1] = av[2], ac = 2;
 	if (ac == 2)
 	{
-		fd = open(av[1], O_RDONLY);
+		fd = open(av[1], O_RDONLY | O_CLOEXEC);
 		if (fd == -1)
 		{
 			if (errno == EACCES)
@@ -38,7 +46,8 @@ int main(int ac, char **av)
 		info->readfd = fd;
 	}
 	populate_env_list(info);
-	read_history(info);
+	info->fname = av[0];
+	trace_open(info);
 	shell(info, av);
 	return (EXIT_SUCCESS);
 }
@@ -1,5 +1,8 @@
 #include "shell.h"
 
+/* the functions, not the tagging macros of shell.h */
+#undef _realloc
+
 /**
  * _memset - Fills memory with a constant byte.
  * @s: A pointer to the memory area.
@@ -43,6 +46,8 @@ void *_realloc(void *ptr, unsigned int old_size, unsigned int new_size)
 {
 	char *p;
 
+	if (new_size && new_size != old_size)
+		shell_stats[ST_REALLOCS]++;
 	if (!ptr)
 		return (malloc(new_size));
 	if (!new_size)
@@ -0,0 +1,121 @@
+#include "shell.h"
+
+/**
+ * par_join - Joins words with single spaces.
+ * @words: The words, the list stops at NULL or at ":::".
+ * @last: A word appended after them, or NULL.
+ *
+ * Return: The malloc'ed command line, or NULL on failure.
+ */
+static char *par_join(char **words, char *last)
+{
+	size_t len = _strlen(last) + 1;
+	char *cmd;
+	int i;
+
+	for (i = 0; words[i] && _strcmp(words[i], ":::"); i++)
+		len += _strlen(words[i]) + 1;
+	cmd = malloc(len);
+	if (!cmd)
+		return (NULL);
+	cmd[0] = 0;
+	for (i = 0; words[i] && _strcmp(words[i], ":::"); i++)
+	{
+		_strcat(cmd, words[i]);
+		_strcat(cmd, " ");
+	}
+	if (last)
+		_strcat(cmd, last);
+	return (cmd);
+}
+
+/**
+ * par_cmds - Builds the command lines a par invocation runs.
+ * @info: Structure containing potential arguments.
+ * @i: Index of the first argument after the options.
+ *
+ * `par cmd args ::: a b' runs "cmd args a" and "cmd args b"; with no
+ * command every non-empty line of stdin is a command.
+ *
+ * Return: A NULL terminated array of command lines, or NULL.
+ */
+char **par_cmds(param_t *info, int i)
+{
+	strbuf_t in = {NULL, 0, 0};
+	char **cmds;
+	int k, n = 0;
+
+	if (!info->argv[i])
+	{
+		while (sb_read_fd(&in, STDIN_FILENO) > 0)
+			;
+		cmds = in.s ? _strtok(in.s, "\n") : NULL;
+		sb_free(&in);
+		return (cmds);
+	}
+	for (k = i; info->argv[k] && _strcmp(info->argv[k], ":::"); k++)
+		;
+	if (info->argv[k])
+		for (n = k + 1; info->argv[n]; n++)
+			;
+	cmds = malloc(sizeof(char *) * (n ? n - k : 2));
+	if (!cmds)
+		return (NULL);
+	if (!n)
+		cmds[0] = par_join(info->argv + i, NULL), cmds[1] = NULL;
+	for (n = 0; info->argv[k] && info->argv[k + n + 1]; n++)
+		cmds[n] = par_join(info->argv + i, info->argv[k + n + 1]);
+	if (info->argv[k])
+		cmds[n] = NULL;
+	return (cmds);
+}
+
+/**
+ * _par - Runs commands on a bounded number of parallel slots.
+ * @info: Structure containing potential arguments. Used to maintain
+ *        a constant function prototype.
+ *
+ * Usage: par [-j N] [cmd [args] ::: arg...]. At most N commands run at
+ * once, N defaults to the number of online CPUs. The output of each job
+ * is buffered and printed in one piece when the job ends, so jobs never
+ * interleave. Each job is a command line run by a forked shell, so it
+ * may hold pipelines, redirections, && and ||.
+ *
+ * Return: 0 if every job succeeded, else the number of failed jobs,
+ *	at most 101, or 2 if the jobs could not be run at all.
+ */
+int _par(param_t *info)
+{
+	long slots = sysconf(_SC_NPROCESSORS_ONLN);
+	int i = 1, failed;
+	char **cmds, *opt;
+
+	if (info->argv[1] && starts_with(info->argv[1], "-j"))
+	{
+		opt = info->argv[1][2] ? info->argv[1] + 2 : info->argv[2];
+		i = info->argv[1][2] ? 2 : 3;
+		slots = opt ? _erratoi(opt) : -1;
+		if (slots <= 0)
+		{
+			_perror(info, "-j needs a positive number\n");
+			return (info->status = 2);
+		}
+	}
+	errno = 0;
+	cmds = par_cmds(info, i);
+	failed = cmds ? par_run(info, cmds, slots < 1 ? 1 : slots)
+		: -(info->argv[i] || errno);
+	ffree(cmds);
+	if (failed < 0)
+	{
+		_perror(info, strerror(errno ? errno : ENOMEM));
+		_eputs("\n");
+		return (info->status = 2);
+	}
+	if (failed)
+	{
+		_perror(info, convert_num_to_str(failed, 10, 0));
+		_eputs(" job(s) failed\n");
+	}
+	return (info->status = failed > 101 ? 101 : failed);
+}
@@ -0,0 +1,169 @@
+#include "shell.h"
+
+/**
+ * par_child - Runs one par job in a forked shell.
+ * @info: Pointer to the parameter & return info struct.
+ * @cmd: The command line, parsed like any other.
+ * @out: The job's stdout pipe.
+ * @err: The job's stderr pipe.
+ *
+ * The child forgets the redirections of the par command itself, as a
+ * command substitution does, before running its own.
+ *
+ * Return: Does not return.
+ */
+static void par_child(param_t *info, char *cmd, int *out, int *err)
+{
+	sigset_t set;
+	int ret;
+
+	sigemptyset(&set);
+	sigprocmask(SIG_SETMASK, &set, NULL);
+	signal(SIGINT, SIG_DFL);
+	trace_child();
+	dup2(out[1], STDOUT_FILENO);
+	dup2(err[1], STDERR_FILENO);
+	info->redir = NULL;
+	info->redirfd = NULL;
+	ret = run_text(info, cmd);
+	_putchar(BUFFER_FLUSH);
+	_eputchar(BUFFER_FLUSH);
+	_exit(ret == -2 ? (info->err_num == -1 ? info->status : info->err_num)
+			: info->status);
+}
+
+/**
+ * par_start - Starts one par job in a free slot.
+ * @info: Pointer to the parameter & return info struct.
+ * @slot: The free slot.
+ * @cmd: The command line to run.
+ *
+ * Return: 0 if the job was started, -1 otherwise.
+ */
+static int par_start(param_t *info, par_slot_t *slot, char *cmd)
+{
+	int out[2], err[2];
+
+	if (pipe2(out, O_CLOEXEC) == -1)
+		return (-1);
+	if (pipe2(err, O_CLOEXEC) == -1)
+		return (close(out[0]), close(out[1]), -1);
+	_putchar(BUFFER_FLUSH);
+	_eputchar(BUFFER_FLUSH);
+	shell_stats[ST_FORKS]++;
+	slot->pid = fork();
+	if (slot->pid == 0)
+		par_child(info, cmd, out, err);
+	close(out[1]), close(err[1]);
+	slot->fd[0] = out[0], slot->fd[1] = err[0];
+	if (slot->pid > 0)
+		return (0);
+	close(out[0]), close(err[0]);
+	slot->pid = 0;
+	return (-1);
+}
+
+/**
+ * par_flush - Writes out everything a job printed and frees its slot.
+ * @slot: The slot of a job whose pipes are both closed.
+ *
+ * Return: 1 if the job failed, 0 otherwise.
+ */
+static int par_flush(par_slot_t *slot)
+{
+	int i, status = 0;
+	ssize_t w;
+	size_t done;
+
+	while (waitpid(slot->pid, &status, 0) == -1 && errno == EINTR)
+		;
+	_putchar(BUFFER_FLUSH);
+	_eputchar(BUFFER_FLUSH);
+	for (i = 0; i < 2; i++)
+	{
+		for (done = 0; done < slot->out[i].len; done += w)
+		{
+			w = write(i + 1, slot->out[i].s + done,
+					slot->out[i].len - done);
+			if (w <= 0 && errno != EINTR)
+				break;
+			w = w < 0 ? 0 : w;
+		}
+		sb_free(&(slot->out[i]));
+	}
+	slot->pid = 0;
+	return (!WIFEXITED(status) || WEXITSTATUS(status));
+}
+
+/**
+ * par_poll - Waits for output from the running jobs.
+ * @slot: The slots.
+ * @n: The number of slots.
+ * @failed: Incremented for every job that ends with a failure.
+ *
+ * Return: The number of jobs that ended.
+ */
+static int par_poll(par_slot_t *slot, int n, int *failed)
+{
+	struct pollfd *pfd = malloc(sizeof(struct pollfd) * n * 2);
+	int i, k = 0, ended = 0;
+
+	if (!pfd)
+		return (0);
+	for (i = 0; i < n * 2; i++)
+		if (slot[i / 2].pid && slot[i / 2].fd[i % 2] >= 0)
+		{
+			pfd[k].fd = slot[i / 2].fd[i % 2];
+			pfd[k].events = POLLIN;
+			pfd[k++].revents = 0;
+		}
+	if (k && poll(pfd, k, -1) == -1)
+		k = 0;
+	for (i = 0, k = 0; i < n * 2; i++)
+		if (slot[i / 2].pid && slot[i / 2].fd[i % 2] >= 0
+				&& pfd[k++].revents
+				&& sb_read_fd(&(slot[i / 2].out[i % 2]),
+					slot[i / 2].fd[i % 2]) <= 0)
+		{
+			close(slot[i / 2].fd[i % 2]);
+			slot[i / 2].fd[i % 2] = -1;
+		}
+	for (i = 0; i < n; i++)
+		if (slot[i].pid && slot[i].fd[0] < 0 && slot[i].fd[1] < 0)
+			*failed += par_flush(&slot[i]), ended++;
+	free(pfd);
+	return (ended);
+}
+
+/**
+ * par_run - Runs command lines with at most n of them at once.
+ * @info: Pointer to the parameter & return info struct.
+ * @cmds: The NULL terminated command lines.
+ * @n: The number of slots.
+ *
+ * Return: The number of jobs that failed or could not be started.
+ */
+int par_run(param_t *info, char **cmds, int n)
+{
+	par_slot_t *slot = malloc(sizeof(par_slot_t) * n);
+	int i, next = 0, running = 0, failed = 0;
+
+	if (!slot)
+		return (-1);
+	_memset((void *)slot, 0, sizeof(par_slot_t) * n);
+	while (cmds[next] || running)
+	{
+		for (i = 0; i < n && cmds[next]; i++)
+			if (!slot[i].pid)
+			{
+				if (par_start(info, &slot[i], cmds[next++]))
+					failed++;
+				else
+					running++;
+			}
+		if (running)
+			running -= par_poll(slot, n, &failed);
+	}
+	free(slot);
+	return (failed);
+}
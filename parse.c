@@ -0,0 +1,158 @@
+#include "shell.h"
+
+/**
+ * cmd_word - Appends a word to the command being parsed.
+ * @cur: Address of the command being parsed, allocated on its first
+ *	word or redirection.
+ * @w: The word, taken over.
+ *
+ * Return: 0 on success, -1 on allocation failure.
+ */
+static int cmd_word(cmd_t **cur, char *w)
+{
+	cmd_t *cmd = *cur;
+	size_t size = sizeof(char *);
+
+	if (!cmd)
+	{
+		cmd = malloc(sizeof(cmd_t));
+		if (!cmd)
+			return (free(w), -1);
+		cmd->argv = NULL;
+		cmd->argc = 0;
+		cmd->op = NORMAL_CMD;
+		cmd->redirs = NULL;
+		cmd->timed = 0;
+		cmd->next = NULL;
+		*cur = cmd;
+	}
+	if (!w)
+		return (0);
+	cmd->argv = (char **)_realloc(cmd->argv, size * (cmd->argc + 1),
+			size * (cmd->argc + 2));
+	if (!cmd->argv)
+		return (free(w), -1);
+	cmd->argv[cmd->argc++] = w;
+	cmd->argv[cmd->argc] = NULL;
+	return (0);
+}
+
+/**
+ * cmd_redir - Appends a redirection to the command being parsed.
+ * @cur: Address of the command being parsed.
+ * @w: The redirection operator, taken over.
+ * @line: Address of the current position in the line.
+ * @bad: Set to the malloc'ed token found instead of the file name, or
+ *	to NULL when there was none.
+ *
+ * Return: 0 on success, -1 on a syntax error or allocation failure.
+ */
+static int cmd_redir(cmd_t **cur, char *w, char **line, char **bad)
+{
+	char *word;
+	redir_t **r;
+	int op;
+
+	*bad = NULL;
+	word = lex_token(line, &op);
+	if (!word || op == REDIR_OP)
+	{
+		*bad = word ? word : _strdup(op_name(op));
+		return (free(w), -1);
+	}
+	if (cmd_word(cur, NULL))
+		return (free(w), free(word), -1);
+	for (r = &((*cur)->redirs); *r; r = &((*r)->next))
+		;
+	*r = new_redir(w, word);
+	return (*r ? 0 : -1);
+}
+
+/**
+ * syntax_error - Replaces a parsed line by a syntax error marker.
+ * @head: The commands parsed so far, freed.
+ * @tok: The unexpected token, taken over.
+ *
+ * Return: A single SYNTAX_CMD command naming the token.
+ */
+static cmd_t *syntax_error(cmd_t *head, char *tok)
+{
+	cmd_t *cmd = NULL;
+
+	free_cmds(head);
+	if (!tok || cmd_word(&cmd, tok))
+		return (free_cmds(cmd), NULL);
+	cmd->op = SYNTAX_CMD;
+	return (cmd);
+}
+
+/**
+ * parse_line - Parses an input line into its simple commands.
+ * @line: The line; comments are cut off in place.
+ *
+ * A pipeline may start with the time keyword, `time' or `time -p',
+ * which is taken off and recorded in its first command.
+ *
+ * Return: The commands in order, NULL for a blank line, or a single
+ *	SYNTAX_CMD command when an operator has no command on one side.
+ */
+cmd_t *parse_line(char *line)
+{
+	cmd_t *head = NULL, **tail = &head, *cur = NULL;
+	int op, dangling = 0, err = 0, timed = 0, piped = 0;
+	char *w;
+
+	del_comments(line);
+	shell_stats[ST_PARSE_LINES]++;
+	while (!err)
+	{
+		w = lex_token(&line, &op);
+		if (op == REDIR_OP && cmd_redir(&cur, w, &line, &w))
+			return (free_cmds(cur), syntax_error(head, w));
+		if (op == REDIR_OP || w)
+		{
+			if (!w || cur || piped || !time_word(w, &timed))
+				err = w && cmd_word(&cur, w);
+			continue;
+		}
+		if (timed && cmd_word(&cur, NULL))
+			return (free_cmds(head), NULL);
+		if (!cur && (dangling || (op != -1 && op != CHAIN_CMD)))
+			return (syntax_error(head, _strdup(op_name(op))));
+		if (cur)
+		{
+			cur->op = op == -1 ? NORMAL_CMD : op;
+			cur->timed = timed;
+			shell_stats[ST_PARSE_CMDS]++;
+		}
+		*tail = cur;
+		tail = cur ? &(cur->next) : tail;
+		cur = NULL;
+		dangling = op == PIPE_CMD || op == AND_CMD || op == OR_CMD;
+		piped = op == PIPE_CMD, timed = 0;
+		if (op == -1)
+			break;
+	}
+	if (err)
+		return (free_cmds(cur), free_cmds(head), NULL);
+	return (head);
+}
+
+/**
+ * free_cmds - Frees a parsed line.
+ * @cmd: The first command.
+ *
+ * Return: void.
+ */
+void free_cmds(cmd_t *cmd)
+{
+	cmd_t *next;
+
+	for (; cmd; cmd = next)
+	{
+		next = cmd->next;
+		ffree(cmd->argv);
+		free_redirs(cmd->redirs);
+		free(cmd);
+	}
+}
@@ -0,0 +1,146 @@
+#include "shell.h"
+
+/**
+ * pc_unlink - Takes an entry out of the recency list, ready to be put
+ *	back at its front.
+ * @pc: The parse cache.
+ * @e: The entry.
+ *
+ * Return: void.
+ */
+static void pc_unlink(parse_cache_t *pc, parse_ent_t *e)
+{
+	if (e->prev)
+		e->prev->next = e->next;
+	else
+		pc->head = e->next;
+	if (e->next)
+		e->next->prev = e->prev;
+	else
+		pc->tail = e->prev;
+	e->prev = NULL;
+	e->next = pc->head;
+}
+
+/**
+ * pc_release - Drops a reference to a parse cache entry.
+ * @e: The entry, freed with its commands once nothing refers to it.
+ *
+ * The cache holds one reference while the entry is in it, and every
+ * line being run holds another, so an entry evicted while it runs, by
+ * `pcache -r' say, stays valid until it is done.
+ *
+ * Return: void.
+ */
+void pc_release(parse_ent_t *e)
+{
+	if (!e || --e->refs)
+		return;
+	free_cmds(e->cmds);
+	free(e->line);
+	free(e);
+}
+
+/**
+ * pc_drop - Drops the least recently used entry of the parse cache.
+ * @pc: The parse cache, not empty.
+ *
+ * Return: void.
+ */
+static void pc_drop(parse_cache_t *pc)
+{
+	parse_ent_t *e = pc->tail, **p;
+
+	p = &(pc->bucket[e->hash % PCACHE_BUCKETS]);
+	while (*p != e)
+		p = &((*p)->chain);
+	*p = e->chain;
+	pc_unlink(pc, e);
+	pc->count--;
+	pc->evictions++;
+	pc_release(e);
+}
+
+/**
+ * pc_lookup - Looks up the parsed form of a line.
+ * @info: Pointer to the parameter & return info struct.
+ * @line: The raw line.
+ *
+ * The cache is allocated on the first lookup. A hit moves the entry to
+ * the front of the recency list.
+ *
+ * Return: The entry, with a reference the caller must release, or NULL.
+ */
+parse_ent_t *pc_lookup(param_t *info, char *line)
+{
+	parse_cache_t *pc = info->pcache;
+	unsigned long h = hash_line(line);
+	parse_ent_t *e;
+
+	if (!pc)
+	{
+		pc = malloc(sizeof(parse_cache_t));
+		if (!pc)
+			return (NULL);
+		_memset((void *)pc, 0, sizeof(parse_cache_t));
+		info->pcache = pc;
+	}
+	e = pc->bucket[h % PCACHE_BUCKETS];
+	while (e && (e->hash != h || _strcmp(e->line, line)))
+		e = e->chain;
+	if (!e)
+	{
+		pc->misses++;
+		return (NULL);
+	}
+	pc->hits++;
+	pc_unlink(pc, e);
+	if (pc->head)
+		pc->head->prev = e;
+	pc->head = e;
+	if (!pc->tail)
+		pc->tail = e;
+	e->refs++;
+	return (e);
+}
+
+/**
+ * pc_insert - Adds a parsed line to the parse cache.
+ * @info: Pointer to the parameter & return info struct.
+ * @line: The raw line, copied.
+ * @cmds: Its parsed commands, owned by the entry on success.
+ *
+ * The cache must have been allocated by pc_lookup(). With @line NULL
+ * the cache is emptied instead.
+ *
+ * Return: The new entry, with a reference the caller must release, or
+ *	NULL on allocation failure.
+ */
+parse_ent_t *pc_insert(param_t *info, char *line, cmd_t *cmds)
+{
+	parse_cache_t *pc = info->pcache;
+	parse_ent_t *e;
+
+	while (pc && pc->count && (!line || pc->count >= PCACHE_SIZE))
+		pc_drop(pc);
+	e = pc && line ? malloc(sizeof(parse_ent_t)) : NULL;
+	if (!e)
+		return (NULL);
+	e->line = _strdup(line);
+	if (!e->line)
+		return (free(e), NULL);
+	e->cmds = cmds;
+	e->refs = 2;
+	e->hash = hash_line(line);
+	e->chain = pc->bucket[e->hash % PCACHE_BUCKETS];
+	pc->bucket[e->hash % PCACHE_BUCKETS] = e;
+	e->prev = NULL;
+	e->next = pc->head;
+	if (pc->head)
+		pc->head->prev = e;
+	pc->head = e;
+	if (!pc->tail)
+		pc->tail = e;
+	pc->count++;
+	return (e);
+}
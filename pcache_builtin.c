@@ -0,0 +1,44 @@
+#include "shell.h"
+
+/**
+ * _pcache - Prints or resets the parse cache counters.
+ * @info: Structure containing potential arguments. Used to maintain
+ *        a constant function prototype.
+ *
+ * `pcache' prints the hits, misses, evictions, entries and hit rate of
+ * the parse cache; `pcache -r' empties it and zeroes the counters.
+ *
+ * Return: 0 on success, 2 on a bad option.
+ */
+int _pcache(param_t *info)
+{
+	parse_cache_t *pc = info->pcache;
+	unsigned long hits = pc ? pc->hits : 0, misses = pc ? pc->misses : 0;
+
+	if (info->argc > 1 && _strcmp(info->argv[1], "-r"))
+	{
+		_eputs(info->fname);
+		_eputs(": pcache: usage: pcache [-r]\n");
+		return (2);
+	}
+	if (info->argc > 1)
+	{
+		pc_insert(info, NULL, NULL);
+		if (pc)
+			pc->hits = pc->misses = pc->evictions = 0;
+		return (0);
+	}
+	_puts("hits=");
+	_puts(convert_num_to_str(hits, 10, CONVERT_UNSIGNED));
+	_puts(" misses=");
+	_puts(convert_num_to_str(misses, 10, CONVERT_UNSIGNED));
+	_puts(" evictions=");
+	_puts(convert_num_to_str(pc ? pc->evictions : 0, 10, CONVERT_UNSIGNED));
+	_puts(" entries=");
+	_puts(convert_num_to_str(pc ? pc->count : 0, 10, 0));
+	_puts(" hit_rate=");
+	_puts(convert_num_to_str(hits + misses ? hits * 100 / (hits + misses)
+				: 0, 10, CONVERT_UNSIGNED));
+	_puts("%\n");
+	return (0);
+}
@@ -0,0 +1,162 @@
+#include "shell.h"
+
+/**
+ * open_pipe - Creates a close-on-exec pipe for the next stage.
+ * @info: Pointer to the parameter & return info struct.
+ * @fds: Where to store the read and write ends.
+ *
+ * The pipe buffer is resized to the value of PIPESIZE when it is set,
+ * so fast producers do not stall on the default 64 KiB buffer.
+ *
+ * Return: 0 on success, -1 on failure.
+ */
+static int open_pipe(param_t *info, int fds[2])
+{
+	char *size = _getenv(info, "PIPESIZE=");
+
+	if (pipe2(fds, O_CLOEXEC) == -1)
+		return (-1);
+	if (size && _atoi(size) > 0)
+		fcntl(fds[1], F_SETPIPE_SZ, _atoi(size));
+	return (0);
+}
+
+/**
+ * stage_path - Looks up the program a pipeline stage runs.
+ * @info: Pointer to the parameter & return info struct, argv is set.
+ *
+ * Return: The path, also stored in info->path, or NULL if not found.
+ */
+static char *stage_path(param_t *info)
+{
+	trace_event("path", 'B', info->argv[0]);
+	info->path = hash_find(info, info->argv[0]);
+	if (!info->path && is_cmd(info, info->argv[0]))
+		info->path = info->argv[0];
+	trace_event("path", 'E', NULL);
+	return (info->path);
+}
+
+/**
+ * run_stage - Starts one stage of a pipeline.
+ * @info: Pointer to the parameter & return info struct, argv is set.
+ * @io: fds to become the stage's stdin, stdout and stderr, -1 to
+ *	inherit one, or NULL to inherit all three.
+ *
+ * Builtins run in a forked copy of the shell so they can take part in
+ * the pipeline or run in the background; other commands are started
+ * with launch_cmd().
+ *
+ * Return: The pid of the stage, or -1 if it could not be started.
+ */
+pid_t run_stage(param_t *info, int *io)
+{
+	int (*func)(param_t *) = get_builtin(info->argv[0]);
+	pid_t pid;
+	int i, ret;
+
+	if (!func)
+	{
+		if (!stage_path(info))
+			return (launch_error(info, ENOENT), -1);
+		_putchar(BUFFER_FLUSH);
+		_eputchar(BUFFER_FLUSH);
+		trace_event("spawn", 'B', info->argv[0]);
+		pid = launch_cmd(info, io);
+		trace_event("spawn", 'E', NULL);
+		if (pid == -1)
+			launch_error(info, errno);
+		return (pid);
+	}
+	_putchar(BUFFER_FLUSH);
+	_eputchar(BUFFER_FLUSH);
+	shell_stats[ST_BUILTINS]++;
+	shell_stats[ST_FORKS]++;
+	pid = fork();
+	if (pid > 0 && info->bg)
+		setpgid(pid, info->pgid ? info->pgid : pid);
+	if (pid != 0)
+		return (pid == -1 ? (perror("Error:"), -1) : pid);
+	if (info->bg)
+		setpgid(0, info->pgid);
+	trace_child();
+	for (i = 0; io && i < 3; i++)
+		if (io[i] >= 0 && io[i] != i)
+			dup2(io[i], i);
+	ret = redir_apply(info, 0) ? 2 : func(info);
+	_putchar(BUFFER_FLUSH);
+	_eputchar(BUFFER_FLUSH);
+	_exit(ret == -2 ? (info->err_num == -1 ? info->status : info->err_num)
+			: ret);
+}
+
+/**
+ * start_stages - Starts every stage before waiting for any of them.
+ * @info: Pointer to the parameter & return info struct.
+ * @cmd: The first command of the pipeline.
+ * @pids: Where to store the pid of each stage, -1 if it did not start.
+ *
+ * Return: The number of stages.
+ */
+static int start_stages(param_t *info, cmd_t *cmd, pid_t *pids)
+{
+	int i, in = -1, fds[2], io[3];
+
+	for (i = 0; cmd; cmd = cmd->op == PIPE_CMD ? cmd->next : NULL, i++)
+	{
+		fds[0] = fds[1] = -1;
+		if (cmd->op == PIPE_CMD && open_pipe(info, fds) == -1)
+			perror("Error:");
+		load_cmd(info, cmd);
+		io[0] = in, io[1] = fds[1], io[2] = -1;
+		pids[i] = -1;
+		if (info->argc && !redir_open(info))
+			pids[i] = run_stage(info, io);
+		if (info->bg && !info->pgid && pids[i] != -1)
+			info->pgid = pids[i];
+		free_param(info, 0);
+		if (in >= 0)
+			close(in);
+		if (fds[1] >= 0)
+			close(fds[1]);
+		in = fds[0];
+	}
+	return (i);
+}
+
+/**
+ * run_pipeline - Runs `cmd | cmd ...' with all stages running at once.
+ * @info: Pointer to the parameter & return info struct.
+ * @cmd: The first command of the pipeline.
+ * @bg: If true the pipeline is started as a job and not waited for.
+ *
+ * The exit status of the pipeline is the one of its last stage.
+ *
+ * Return: The exit status.
+ */
+int run_pipeline(param_t *info, cmd_t *cmd, int bg)
+{
+	pid_t *pids;
+	cmd_t *c;
+	int i, n, status;
+
+	for (n = 1, c = cmd; c->op == PIPE_CMD && c->next; c = c->next)
+		n++;
+	pids = malloc(sizeof(pid_t) * n);
+	if (!pids)
+		return (info->status);
+	info->bg = bg;
+	info->pgid = 0;
+	start_stages(info, cmd, pids);
+	status = info->status;
+	if (bg && add_job(info, pids, n, cmd_text(cmd)))
+		info->status = 0;
+	for (i = 0; !bg && i < n; i++)
+		if (pids[i] != -1)
+			wait_child(info, pids[i]);
+	if (!bg && pids[n - 1] == -1)
+		info->status = status;
+	free(pids);
+	info->bg = 0;
+	return (info->status);
+}
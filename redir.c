@@ -0,0 +1,137 @@
+#include "shell.h"
+
+/**
+ * redir_error - Reports a redirection that failed.
+ * @info: Pointer to the parameter & return info struct.
+ * @what: What was being done, as in "cannot open ".
+ * @word: The word of the redirection.
+ *
+ * Return: Always -1, with the status set to 2.
+ */
+int redir_error(param_t *info, char *what, char *word)
+{
+	char *err = strerror(errno);
+
+	_eputs(info->fname);
+	_eputs(": ");
+	print_d(info->line_count, STDERR_FILENO);
+	_eputs(": ");
+	_eputs(what);
+	_eputs(word);
+	_eputs(": ");
+	_eputs(err);
+	_eputchar('\n');
+	info->status = 2;
+	return (-1);
+}
+
+/**
+ * redir_src - Gets the fd a redirection copies from.
+ * @info: Pointer to the parameter & return info struct.
+ * @r: The redirection.
+ * @w: Its word, expanded.
+ *
+ * Files and here-documents are opened close-on-exec and moved above
+ * fd 9, so they cannot clash with an fd being redirected.
+ *
+ * Return: The fd, -2 for >&- or <&-, or -1 after reporting an error.
+ */
+static int redir_src(param_t *info, redir_t *r, char *w)
+{
+	int fd, flags;
+
+	if (r->type == REDIR_DUP)
+	{
+		fd = _strcmp(w, "-") ? _erratoi(w) : -2;
+		if (!*w || fd == -1)
+			return (errno = EBADF, redir_error(info, "", w));
+		return (fd);
+	}
+	flags = r->type == REDIR_IN ? O_RDONLY : O_WRONLY | O_CREAT
+		| (r->type == REDIR_APPEND ? O_APPEND : O_TRUNC);
+	if (r->type >= REDIR_HEREDOC)
+		fd = heredoc_fd(w, r->type == REDIR_HERESTR);
+	else
+		fd = open(w, flags | O_CLOEXEC, 0666);
+	if (fd >= 0 && fd < 10)
+	{
+		flags = fcntl(fd, F_DUPFD_CLOEXEC, 10);
+		close(fd);
+		fd = flags;
+	}
+	if (fd == -1 && r->type >= REDIR_HEREDOC)
+		return (redir_error(info, "", "here-document"));
+	if (fd == -1)
+		return (redir_error(info, r->type == REDIR_IN ? "cannot open "
+					: "cannot create ", w));
+	return (fd);
+}
+
+/**
+ * redir_open - Opens the files of the current command's redirections.
+ * @info: Pointer to the parameter & return info struct, redir is set.
+ *
+ * The redirections are then applied with dup2(), by redir_apply() in
+ * the shell or as spawn file actions in the child; redir_close() closes
+ * the files again. Command substitutions in file names and here-strings
+ * and the bodies of here-documents are expanded here, without field
+ * splitting.
+ *
+ * Return: 0 on success, -1 with the status set to 2 on failure.
+ */
+int redir_open(param_t *info)
+{
+	redir_fd_t *f;
+	redir_t *r;
+	char *w;
+	int n = 0;
+
+	for (r = info->redir; r; r = r->next)
+		n++;
+	if (!n)
+		return (0);
+	f = malloc(sizeof(redir_fd_t) * (n + 1));
+	info->redirfd = f;
+	if (!f)
+		return (-1);
+	for (r = info->redir; r; r = r->next, f++)
+	{
+		f->fd = r->fd;
+		f->src = -1;
+		f->saved = -1;
+		f->flags = -2;
+	}
+	f->fd = -1;
+	for (f = info->redirfd, r = info->redir; r; r = r->next, f++)
+	{
+		w = r->word;
+		if (r->type == REDIR_HEREDOC || r->type == REDIR_HEREDOC_TABS)
+			w = heredoc_expand(info, w);
+		else if (r->type != REDIR_HEREDOC_RAW && has_subst(w))
+			w = expand_word(info, w);
+		f->src = w ? redir_src(info, r, w) : -1;
+		if (w != r->word)
+			free(w);
+		if (f->src == -1)
+			return (redir_close(info), -1);
+	}
+	return (0);
+}
+
+/**
+ * redir_close - Closes the files opened by redir_open().
+ * @info: Pointer to the parameter & return info struct.
+ *
+ * Return: void.
+ */
+void redir_close(param_t *info)
+{
+	redir_fd_t *f = info->redirfd;
+	redir_t *r = info->redir;
+
+	for (; f && f->fd != -1; f++, r = r->next)
+		if (r->type != REDIR_DUP && f->src >= 0)
+			close(f->src);
+	free(info->redirfd);
+	info->redirfd = NULL;
+}
@@ -0,0 +1,65 @@
+#include "shell.h"
+
+/**
+ * redir_apply - Applies the current command's redirections in the shell.
+ * @info: Pointer to the parameter & return info struct.
+ * @save: If true, every fd replaced is saved for redir_restore().
+ *
+ * Builtins run this way, without a fork; forked children apply them
+ * with @save false.
+ *
+ * Return: 0 on success, -1 with the status set to 2 on failure.
+ */
+int redir_apply(param_t *info, int save)
+{
+	redir_fd_t *f = info->redirfd;
+	redir_t *r = info->redir;
+
+	_putchar(BUFFER_FLUSH);
+	_eputchar(BUFFER_FLUSH);
+	for (; f && f->fd != -1; f++, r = r->next)
+	{
+		if (save)
+		{
+			f->flags = fcntl(f->fd, F_GETFD);
+			f->saved = f->flags == -1 ? -1
+				: fcntl(f->fd, F_DUPFD_CLOEXEC, 10);
+		}
+		if (f->src == -2)
+			close(f->fd);
+		else if (f->src != f->fd && dup2(f->src, f->fd) == -1)
+			return (redir_error(info, "", r->word));
+	}
+	return (0);
+}
+
+/**
+ * redir_restore - Undoes redir_apply(), last redirection first.
+ * @info: Pointer to the parameter & return info struct.
+ *
+ * Return: void.
+ */
+void redir_restore(param_t *info)
+{
+	redir_fd_t *f = info->redirfd;
+	int n = 0;
+
+	_putchar(BUFFER_FLUSH);
+	_eputchar(BUFFER_FLUSH);
+	while (f && f[n].fd != -1)
+		n++;
+	while (n--)
+	{
+		if (f[n].flags == -2)
+			continue;
+		if (f[n].saved == -1)
+			close(f[n].fd);
+		else
+		{
+			dup3(f[n].saved, f[n].fd,
+				f[n].flags & FD_CLOEXEC ? O_CLOEXEC : 0);
+			close(f[n].saved);
+		}
+		f[n].flags = -2;
+	}
+}
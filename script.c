@@ -0,0 +1,118 @@
+#include "shell.h"
+
+/**
+ * compile_script - Compiles the script open on info->readfd.
+ * @info: Pointer to the parameter & return info struct.
+ * @bc: The bytecode buffer, holding the header already.
+ *
+ * The whole script is read at once; each line is parsed and appended
+ * to the bytecode, blank and comment lines are left out. Here-document
+ * bodies are compiled into the line that uses them.
+ *
+ * Return: 0 on success, -1 on failure.
+ */
+int compile_script(param_t *info, strbuf_t *bc)
+{
+	strbuf_t text = {NULL, 0, 0};
+	unsigned int n = 0;
+	char *line, *nl, *next;
+	cmd_t *cmds;
+	int err = 0, k;
+	ssize_t r;
+
+	trace_event("compile", 'B', NULL);
+	do {
+		r = sb_read_fd(&text, info->readfd);
+	} while (r > 0);
+	if (r == -1 || !text.s)
+		return (trace_event("compile", 'E', NULL), sb_free(&text), -1);
+	for (line = text.s; line && !err; line = next)
+	{
+		n++;
+		nl = _strchr(line, '\n');
+		if (nl)
+			*nl = 0;
+		next = nl ? nl + 1 : NULL;
+		cmds = parse_line(line);
+		heredoc_fill(info, cmds, &next, &k);
+		if (cmds)
+			err = bc_put_line(bc, n, cmds);
+		n += k;
+		free_cmds(cmds);
+	}
+	sb_free(&text);
+	trace_event("compile", 'E', NULL);
+	return (err ? -1 : 0);
+}
+
+/**
+ * load_script - Gets the bytecode of the script open on info->readfd.
+ * @info: Pointer to the parameter & return info struct.
+ * @bc: The empty bytecode buffer.
+ *
+ * The cached code is used while the device, inode, mtime and size of
+ * the script match; otherwise the script is compiled and cached again.
+ *
+ * Return: 0 on success, -1 if the script must be read line by line.
+ */
+static int load_script(param_t *info, strbuf_t *bc)
+{
+	struct stat st;
+
+	if (fstat(info->readfd, &st) || !S_ISREG(st.st_mode))
+		return (-1);
+	if (!bc_load(info, &st, bc))
+		return (0);
+	if (bc_header(bc, &st) || compile_script(info, bc))
+	{
+		sb_free(bc);
+		lseek(info->readfd, 0, SEEK_SET);
+		return (-1);
+	}
+	bc_save(info, &st, bc);
+	return (0);
+}
+
+/**
+ * run_script - Runs a script file from its compiled bytecode.
+ * @info: Pointer to the parameter & return info struct.
+ * @av: The argument vector from main().
+ * @builtin_ret: Where to store -2 if the script ran exit.
+ *
+ * This replaces the get_input() loop for script files: each line is
+ * decoded and run, with no lexing at all.
+ * Script lines are not added to the history.
+ *
+ * Return: -1 once the script ran, 0 if it must be read line by line.
+ */
+int run_script(param_t *info, char **av, int *builtin_ret)
+{
+	strbuf_t bc = {NULL, 0, 0};
+	size_t pos = BC_HEADER_SIZE;
+	unsigned int line = 0;
+	unsigned long mark[3];
+	cmd_t *cmds;
+
+	if (load_script(info, &bc))
+		return (0);
+	info->fname = av[0];
+	while (*builtin_ret != -2)
+	{
+		cmds = bc_get_line(&bc, &pos, &line);
+		if (!cmds)
+			break;
+		if (info->jobs)
+			reap_jobs(info);
+		info->line_count = line;
+		prof_mark(mark);
+		*builtin_ret = lprof_run(info, cmds, line);
+		prof_command(cmds->argc ? cmds->argv[0] : NULL, mark);
+		free_cmds(cmds);
+		_eputchar(BUFFER_FLUSH);
+	}
+	info->arg = NULL;
+	sb_free(&bc);
+	_putchar(BUFFER_FLUSH);
+	_eputchar(BUFFER_FLUSH);
+	return (-1);
+}
@@ -1,6 +1,8 @@
 #ifndef _SHELL_H_
 #define _SHELL_H_
 
+#define _GNU_SOURCE
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
@@ -11,6 +13,15 @@
 #include <limits.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <time.h>
+#include <signal.h>
+#include <spawn.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <sys/file.h>
+#include <sys/time.h>
+#include <sys/resource.h>
 
 /* for read/write buffers */
 #define BUF_READ_SIZE 1024
@@ -22,6 +33,27 @@
 #define OR_CMD		1
 #define AND_CMD		2
 #define CHAIN_CMD	3
+#define PIPE_CMD	4
+#define BG_CMD		5
+#define SYNTAX_CMD	6
+
+/* lex_token() operator for a redirection, see lex.c */
+#define REDIR_OP	7
+
+/* redirection types */
+#define REDIR_IN	0
+#define REDIR_OUT	1
+#define REDIR_APPEND	2
+#define REDIR_DUP	3
+#define REDIR_HEREDOC	4
+#define REDIR_HEREDOC_TABS	5
+#define REDIR_HERESTR	6
+#define REDIR_HEREDOC_RAW	7
+
+/* how a timed pipeline reports, see the time keyword */
+#define TIME_HUMAN	1
+#define TIME_POSIX	2
+#define TIME_KEYS	3
 
 /* for convert_num_to_str() */
 #define CONVERT_LC	1
@@ -31,10 +63,83 @@
 #define GETLINE 0
 #define _STRTOK 0
 
+/* 1 if script files run from cached bytecode, see script.c */
+#define COMPILE_SCRIPTS 1
+
+/* 1 if launching commands with posix_spawn(), 0 to fall back to fork() */
+#define USE_SPAWN 1
+
 #define HISTORY_FILE	".shell_history"
+/* the history entries kept when HISTSIZE is unset, see hist_size() */
 #define HISTORY_MAX	4096
 
+/* the offset index beside the history file, see hist_file.c */
+#define HIST_INDEX	".idx"
+
+/* the size of a "#t" timing line of the history file, see hist_time_fmt() */
+#define HIST_TIME_LEN	96
+
+/* the history file is not compacted at exit below this size */
+#define HIST_COMPACT_MIN	65536
+
+/* the bytes of an entry the prefix trie of history -s goes down */
+#define HIST_TRIE_DEPTH	8
+
+/* for the job table */
+#define JOB_RUNNING	0
+#define JOB_STOPPED	1
+#define JOB_DONE	2
+#define JOBS_DONE_MAX	64
+
+/* compiled script cache, see bytecode.c */
+#define BC_MAGIC	"HSBC"
+#define BC_VERSION	7
+#define BC_HEADER_SIZE	53
+#define BC_DIR		"hsh"
+#define BC_LINE		'L'
+#define BC_CMD		'C'
+
+/* smallest read issued by sb_read_fd() */
+#define SB_READ_SIZE	65536
+
+/* buckets in the command hash table */
+#define CMD_HASH_SIZE	64
+
+/* shell_stats[] counters, see the shellstats builtin */
+#define ST_PARSE_LINES	0
+#define ST_PARSE_CMDS	1
+#define ST_BUILTINS	2
+#define ST_EXECS	3
+#define ST_FORKS	4
+#define ST_SPAWNS	5
+#define ST_STATS	6
+#define ST_READS	7
+#define ST_READ_BYTES	8
+#define ST_WRITES	9
+#define ST_WRITE_BYTES	10
+#define ST_ENVIRON	11
+#define ST_STRDUPS	12
+#define ST_REALLOCS	13
+#define ST_LIST_NODES	14
+#define ST_COUNT	15
+
+/* buffered SHELL_TRACE events written at once, see trace_event.c */
+#define TRACE_FLUSH_SIZE	65536
+
+/* 1 if the SHELL_ALLOCPROF allocation profiler is built in */
+#define ALLOC_PROF	1
+
+/* call sites and command names the profiler tells apart, see alloc_prof.c */
+#define PROF_SITES	1024
+#define PROF_CMDS	64
+#define PROF_TOP	20
+
+/* lines kept in the parse cache, and its buckets */
+#define PCACHE_SIZE	256
+#define PCACHE_BUCKETS	128
+
 extern char **environ;
+extern unsigned long shell_stats[ST_COUNT];
 
 
 /**
@@ -50,6 +155,474 @@ typedef struct s_linked_list
 	struct s_linked_list *next;
 } list_t;
 
+/**
+ * struct strbuf - a growable byte buffer
+ * @s: the bytes, null terminated when not empty
+ * @len: number of bytes used
+ * @cap: number of bytes allocated
+ */
+typedef struct strbuf
+{
+	char *s;
+	size_t len;
+	size_t cap;
+} strbuf_t;
+
+/**
+ * struct redir - a redirection of a simple command
+ * @fd: the fd redirected
+ * @type: REDIR_IN for <, REDIR_OUT for >, REDIR_APPEND for >>,
+ *	REDIR_DUP for >& and <&, REDIR_HEREDOC for <<, REDIR_HEREDOC_TABS
+ *	for <<-, REDIR_HERESTR for <<< and REDIR_HEREDOC_RAW for a
+ *	here-document whose delimiter was quoted, once its body is read
+ * @word: the file name, for REDIR_DUP the fd to copy or "-", for a
+ *	here-document its delimiter until heredoc_fill() replaces it by
+ *	the body, and for a here-string the string
+ * @next: points to the next redirection, applied after this one
+ */
+typedef struct redir
+{
+	int fd;
+	int type;
+	char *word;
+	struct redir *next;
+} redir_t;
+
+/**
+ * struct redir_fd - the fds behind a redirection while it is applied
+ * @fd: the fd redirected
+ * @src: the fd copied onto it: the file the shell opened for it, the
+ *	fd of a >& or <&, or -2 to close it
+ * @saved: a copy of what @fd was before, -1 if it was not open
+ * @flags: the fd flags @fd had, -2 while it was not saved
+ */
+typedef struct redir_fd
+{
+	int fd;
+	int src;
+	int saved;
+	int flags;
+} redir_fd_t;
+
+/**
+ * struct cmd - a simple command of a parsed line
+ * @argv: the words as written, expanded only when the command runs
+ * @argc: the number of words
+ * @op: how the command connects to the next one: NORMAL_CMD at the end
+ *	of the line, OR_CMD, AND_CMD, CHAIN_CMD, PIPE_CMD or BG_CMD;
+ *	SYNTAX_CMD marks a line that failed to parse, argv[0] being the
+ *	unexpected token
+ * @redirs: the redirections, in the order written
+ * @timed: TIME_HUMAN, TIME_POSIX or TIME_KEYS if the pipeline starting
+ *	with this command follows the time keyword, 0 otherwise
+ * @next: points to the next command
+ */
+typedef struct cmd
+{
+	char **argv;
+	int argc;
+	int op;
+	redir_t *redirs;
+	int timed;
+	struct cmd *next;
+} cmd_t;
+
+/**
+ * struct timing - resources used by a timed pipeline so far
+ * @start: when it started, on the monotonic clock
+ * @self: the shell's own usage when it started
+ * @kids: usage of the children waited for since, summed by wait_child()
+ * @nkids: the number of those children
+ * @waited: microseconds the shell spent blocked on children since
+ * @prev: the timing this one is nested in, or NULL
+ */
+typedef struct timing
+{
+	struct timespec start;
+	struct rusage self;
+	struct rusage kids;
+	int nkids;
+	long waited;
+	struct timing *prev;
+} timing_t;
+
+/**
+ * struct line_prof - what the runs of one script line took, see --profile
+ * @line: the line number, 0 for a line that never ran
+ * @count: how many times it ran
+ * @total: the wall clock time it took, in microseconds
+ * @self: the part of it the shell was not waiting for children
+ */
+typedef struct line_prof
+{
+	unsigned int line;
+	unsigned long count;
+	long total;
+	long self;
+} line_prof_t;
+
+/**
+ * struct par_slot - a job started by the par builtin
+ * @pid: the job's process, 0 when the slot is free
+ * @fd: read ends of the job's stdout and stderr pipes, -1 once closed
+ * @out: what the job wrote to stdout and stderr so far
+ */
+typedef struct par_slot
+{
+	pid_t pid;
+	int fd[2];
+	strbuf_t out[2];
+} par_slot_t;
+
+/**
+ * struct env_map - the environment, a hash table of its variables
+ * @var: the "name=value" strings, in the order they were first set,
+ *	NULL where one was removed
+ * @len: the strings and holes in @var
+ * @cap: how many fit
+ * @count: the variables set
+ * @slot: the table, open addressing: one plus the index of a string in
+ *	@var, 0 for a free slot, -1 for a removed one
+ * @slots: its size, a power of two, 0 until the first variable
+ */
+typedef struct env_map
+{
+	char **var;
+	size_t len;
+	size_t cap;
+	size_t count;
+	long *slot;
+	size_t slots;
+} env_map_t;
+
+/**
+ * struct cmd_hash - remembered PATH lookups, see the hash builtin
+ * @bucket: chains of "name=path" nodes, "name=" for a cached miss,
+ *	num holds the hit count of each entry
+ * @stamps: the mtime of each PATH directory when the table was filled,
+ *	see path_stamp()
+ * @hits: lookups answered from the table
+ * @misses: lookups that had to search PATH
+ */
+typedef struct cmd_hash
+{
+	list_t *bucket[CMD_HASH_SIZE];
+	strbuf_t stamps;
+	unsigned long hits;
+	unsigned long misses;
+} cmd_hash_t;
+
+/**
+ * struct job - a background job, see the jobs builtin
+ * @id: the job number shown as %id
+ * @pgid: the process group of the job's processes
+ * @last: pid of the last stage, its status is the job's status
+ * @nprocs: number of processes not reaped yet
+ * @status: the exit status of the last stage once it is reaped
+ * @state: JOB_RUNNING, JOB_STOPPED or JOB_DONE
+ * @cmd: the command line that started the job
+ * @next: points to the next job
+ */
+typedef struct job
+{
+	int id;
+	pid_t pgid;
+	pid_t last;
+	int nprocs;
+	int status;
+	int state;
+	char *cmd;
+	struct job *next;
+} job_t;
+
+/**
+ * struct parse_ent - a parsed line in the parse cache
+ * @hash: hash of the raw line
+ * @line: the raw line
+ * @cmds: its parsed commands, owned by the entry
+ * @refs: references held by the cache and by the lines running it
+ * @prev: the more recently used entry
+ * @next: the less recently used entry
+ * @chain: the next entry in the same bucket
+ */
+typedef struct parse_ent
+{
+	unsigned long hash;
+	char *line;
+	cmd_t *cmds;
+	int refs;
+	struct parse_ent *prev;
+	struct parse_ent *next;
+	struct parse_ent *chain;
+} parse_ent_t;
+
+/**
+ * struct parse_cache - LRU cache of parsed lines, see the pcache builtin
+ * @bucket: chains of entries by hash
+ * @head: the most recently used entry
+ * @tail: the least recently used entry, evicted first
+ * @count: the number of entries
+ * @hits: lines found in the cache
+ * @misses: lines that had to be parsed
+ * @evictions: entries dropped to make room
+ */
+typedef struct parse_cache
+{
+	parse_ent_t *bucket[PCACHE_BUCKETS];
+	parse_ent_t *head;
+	parse_ent_t *tail;
+	int count;
+	unsigned long hits;
+	unsigned long misses;
+	unsigned long evictions;
+} parse_cache_t;
+
+/**
+ * struct trace - the SHELL_TRACE event writer
+ * @fd: the trace file, -1 when tracing is off
+ * @buf: events not written yet
+ * @start: when tracing started, timestamps count from it
+ * @tail: the pid and tid fields every event ends with
+ * @count: the number of events so far, to place the commas
+ */
+typedef struct trace
+{
+	int fd;
+	strbuf_t buf;
+	struct timespec start;
+	char tail[32];
+	unsigned long count;
+} trace_t;
+
+extern trace_t shell_trace;
+
+/**
+ * struct alloc_site - the allocations made at one place of the source
+ * @file: the source file, NULL for a free slot
+ * @line: the line of the call
+ * @allocs: the number of allocations made there
+ * @bytes: the number of bytes they asked for
+ * @live: the number of those blocks not freed yet
+ * @live_bytes: their size
+ */
+typedef struct alloc_site
+{
+	const char *file;
+	int line;
+	unsigned long allocs;
+	unsigned long bytes;
+	unsigned long live;
+	unsigned long live_bytes;
+} alloc_site_t;
+
+/**
+ * struct alloc_hdr - what the profiler keeps in front of a block
+ * @size: the size asked for
+ * @site: where the block was allocated
+ *
+ * Two words, so the block after it stays aligned like malloc()'s.
+ */
+typedef struct alloc_hdr
+{
+	size_t size;
+	alloc_site_t *site;
+} alloc_hdr_t;
+
+/**
+ * struct alloc_cmd - the allocations made running one command name
+ * @name: the first word of the lines, "" for a free slot
+ * @runs: the number of lines run
+ * @allocs: the number of allocations they made
+ * @bytes: the number of bytes they asked for
+ * @peak: the most the live bytes grew during one of them
+ */
+typedef struct alloc_cmd
+{
+	char name[32];
+	unsigned long runs;
+	unsigned long allocs;
+	unsigned long bytes;
+	unsigned long peak;
+} alloc_cmd_t;
+
+/**
+ * struct alloc_prof - the SHELL_ALLOCPROF allocation profiler
+ * @on: 1 if profiling, 0 if not, -1 until the first allocation
+ * @depth: how deep the calls of tagged helpers like _strdup() nest
+ * @file: the source file the outermost of them was called from
+ * @line: the line it was called from
+ * @sites: the call sites, PROF_SITES slots
+ * @cmds: the command names, PROF_CMDS slots
+ * @allocs: the number of allocations
+ * @frees: the number of blocks freed
+ * @bytes: the number of bytes asked for
+ * @live: the number of bytes allocated and not freed
+ * @peak: the most @live has been
+ * @top: the most @live has been during the current command
+ */
+typedef struct alloc_prof
+{
+	int on;
+	int depth;
+	const char *file;
+	int line;
+	alloc_site_t *sites;
+	alloc_cmd_t *cmds;
+	unsigned long allocs;
+	unsigned long frees;
+	unsigned long bytes;
+	unsigned long live;
+	unsigned long peak;
+	unsigned long top;
+} alloc_prof_t;
+
+extern alloc_prof_t alloc_prof;
+
+/**
+ * struct hist_time - what running a history entry took
+ * @start: when it started, in seconds since the epoch, 0 if unknown
+ * @usec: the wall clock time it took, in microseconds
+ * @cpu: the user and system CPU time it used, in microseconds
+ * @status: its exit status
+ */
+typedef struct hist_time
+{
+	time_t start;
+	long usec;
+	long cpu;
+	int status;
+} hist_time_t;
+
+/**
+ * struct hist_ent - a history entry
+ * @off: where its line starts in the arena of the history
+ * @len: the length of the line
+ * @time: what running it took, its start is 0 if it was not timed
+ */
+typedef struct hist_ent
+{
+	size_t off;
+	size_t len;
+	hist_time_t time;
+} hist_ent_t;
+
+/**
+ * struct hist_gram - the entries a trigram occurs in, see hist_gram.c
+ * @key: the three bytes, plus one, 0 for a free slot
+ * @post: the history numbers of the entries, as ints, oldest first
+ */
+typedef struct hist_gram
+{
+	unsigned int key;
+	strbuf_t post;
+} hist_gram_t;
+
+/**
+ * struct hist_node - a node of the prefix trie of the history
+ * @c: the byte that leads to it
+ * @child: its first child, 0 for none
+ * @next: its next sibling, 0 for none
+ * @first: the number of the oldest entry whose first bytes lead to it,
+ *	for entries that end there or are cut at HIST_TRIE_DEPTH, -1 for
+ *	none; the others follow in the links of the index
+ * @last: the number of the newest one
+ */
+typedef struct hist_node
+{
+	unsigned char c;
+	int child;
+	int next;
+	int first;
+	int last;
+} hist_node_t;
+
+/**
+ * struct hist_find - the search index of the history, see hist_search.c
+ * @gram: the trigram table, open addressing
+ * @grams: its size, a power of two, 0 until the first trigram
+ * @ngram: the trigrams in it
+ * @node: the trie nodes, the root first
+ * @nodes: how many there are
+ * @nodecap: how many fit
+ * @link: for each entry from @start on, as ints, the number of the next
+ *	one at the same trie node, -1 for none
+ * @start: the number of the first entry indexed
+ * @next: the number of the next entry to index
+ */
+typedef struct hist_find
+{
+	hist_gram_t *gram;
+	size_t grams;
+	size_t ngram;
+	hist_node_t *node;
+	int nodes;
+	int nodecap;
+	strbuf_t link;
+	int start;
+	int next;
+} hist_find_t;
+
+/**
+ * struct hist_ring - the history, a ring of entries over a ring of bytes
+ * @ent: the entry slots
+ * @slots: how many there are, grown as needed up to @cap
+ * @cap: the most entries kept, from HISTSIZE
+ * @first: the slot of the oldest entry
+ * @count: the number of entries
+ * @base: the history number of the oldest entry
+ * @arena: the lines, each ending with a NUL, in the order of the entries
+ * @size: the size of the arena
+ * @tail: the end of the newest line in the arena
+ * @used: the bytes the lines take in the arena
+ * @stale: on when HISTSIZE changed since @cap was set
+ * @fd: the history file, open for appending, or -1
+ * @idxfd: its offset index, open for appending, or -1
+ * @reindex: on when the index did not match the file, which is then
+ *	compacted at exit to write a new one
+ * @origin: the offset of the start of the file, see hist_file.c
+ * @seen: the offset the file was read up to, see hist_pull()
+ * @mark: the offset just past the last entry this shell appended
+ * @own: the lines this shell appended past @seen, as pairs of offsets
+ * @find: the search index, NULL until history -s
+ */
+typedef struct hist_ring
+{
+	hist_ent_t *ent;
+	size_t slots;
+	size_t cap;
+	size_t first;
+	size_t count;
+	int base;
+	char *arena;
+	size_t size;
+	size_t tail;
+	size_t used;
+	int stale;
+	int fd;
+	int idxfd;
+	int reindex;
+	long origin;
+	long seen;
+	long mark;
+	strbuf_t own;
+	hist_find_t *find;
+} hist_ring_t;
+
+/**
+ * struct hist_row - a timed history entry, see history --stats
+ * @name: the command name, the first word of the entry
+ * @len: the length of the name
+ * @usec: the wall clock time the entry took
+ * @status: its exit status
+ */
+typedef struct hist_row
+{
+	char *name;
+	int len;
+	long usec;
+	int status;
+} hist_row_t;
+
 /**
  * struct param - contains pseudo-arguements to pass into a function,
  * allowing uniform prototype for function pointer struct
@@ -61,16 +634,28 @@ typedef struct s_linked_list
  * @err_num: the error code for exit()s
  * @linecount_flag: if on count this line of input
  * @fname: the program filename
- * @env: linked list local copy of environ
- * @environ: custom modified copy of environ from LL env
- * @history: the history node
+ * @env: local copy of environ, see env_map.c
+ * @environ: array of the strings of @env, for execve(), rebuilt when it
+ *	changed
+ * @hist: the history, allocated when first loaded, see hist_load()
  * @alias: the alias node
  * @env_changed: on if environ was changed
  * @status: the return status of the last exec'd command
- * @cmd_buf: address of pointer to cmd_buf, on if chaining
- * @cmd_buf_type: CMD_type ||, &&, ;
+ * @cmd_buf: address of pointer to cmd_buf, the input line buffer
  * @readfd: the fd from which to read line input
- * @histcount: the history line number count
+ * @histcount: the number the next history entry gets
+ * @cmdhash: the command hash table, allocated on first lookup
+ * @jobs: the job table
+ * @bg: on if the current command ends with '&'
+ * @pgid: process group children of a background job join, 0 for new
+ * @last_bg: pid of the last background command, for $!
+ * @pcache: the parse cache, allocated on first use
+ * @redir: the redirections of the current command
+ * @redirfd: the fds behind each of those redirections, see redir_open()
+ * @timing: the innermost pipeline being timed, or NULL
+ * @profile: the script being profiled with --profile, or NULL
+ * @lineprof: a line_prof_t for each line of that script, by number
+ * @histload: on once the history file was read, see hist_load()
  */
 typedef struct param
 {
@@ -82,22 +667,34 @@ typedef struct param
 	int err_num;
 	int linecount_flag;
 	char *fname;
-	list_t *env;
-	list_t *history;
+	env_map_t *env;
+	hist_ring_t *hist;
 	list_t *alias;
 	char **environ;
 	int env_changed;
 	int status;
 
-	char **cmd_buf; /* pointer to cmd ; chain buffer, for memory mangement */
-	int cmd_buf_type; /* CMD_type ||, &&, ; */
+	char **cmd_buf; /* pointer to the input buffer, for memory management */
 	int readfd;
 	int histcount;
+	cmd_hash_t *cmdhash;
+	job_t *jobs;
+	int bg;
+	pid_t pgid;
+	pid_t last_bg;
+	parse_cache_t *pcache;
+	redir_t *redir;
+	redir_fd_t *redirfd;
+	timing_t *timing;
+	char *profile;
+	strbuf_t lineprof;
+	int histload;
 } param_t;
 
 #define PARAM_INIT \
 {NULL, NULL, NULL, 0, 0, 0, 0, NULL, NULL, NULL, NULL, NULL, 0, 0, NULL, \
-		0, 0, 0}
+		0, 0, NULL, NULL, 0, 0, 0, NULL, NULL, NULL, NULL, NULL, \
+		{NULL, 0, 0}, 0}
 
 /**
  * struct builtin - contains a builtin string and related function
@@ -114,6 +711,7 @@ typedef struct builtin
 /* toem_shloop.c */
 int shell(param_t *, char **);
 int find_builtin(param_t *);
+int (*get_builtin(char *))(param_t *);
 void find_cmd(param_t *);
 void fork_cmd(param_t *);
 
@@ -122,6 +720,180 @@ int is_cmd(param_t *, char *);
 char *dup_chars(char *, int, int);
 char *find_path(param_t *, char *, char *);
 
+/* cmd_hash.c */
+char *hash_find(param_t *, char *);
+void hash_clear(param_t *);
+int path_stamp(char *, strbuf_t *);
+
+/* launcher.c */
+pid_t launch_cmd(param_t *, int *);
+void launch_error(param_t *, int);
+int wait_child(param_t *, pid_t);
+
+/* pipeline.c */
+int run_pipeline(param_t *, cmd_t *, int);
+pid_t run_stage(param_t *, int *);
+
+/* lex.c */
+char *lex_token(char **, int *);
+redir_t *new_redir(char *, char *);
+void free_redirs(redir_t *);
+char *op_name(int);
+int time_word(char *, int *);
+
+/* redir.c */
+int redir_error(param_t *, char *, char *);
+int redir_open(param_t *);
+void redir_close(param_t *);
+
+/* redir_apply.c */
+int redir_apply(param_t *, int);
+void redir_restore(param_t *);
+
+/* heredoc.c */
+int heredoc_fill(param_t *, cmd_t *, char **, int *);
+
+/* heredoc_fd.c */
+int heredoc_fd(char *, int);
+
+/* heredoc_expand.c */
+char *heredoc_expand(param_t *, char *);
+
+/* subst.c */
+int is_subst(char *);
+int has_subst(char *);
+size_t subst_len(char *, size_t *);
+int subst_run(param_t *, char *, strbuf_t *);
+
+/* expand.c */
+void expand_fields(param_t *, char *, char *, strbuf_t *);
+char *expand_word(param_t *, char *);
+int expand_args(param_t *);
+
+/* timing.c */
+void time_start(param_t *, timing_t *);
+void time_add(timing_t *, struct rusage *);
+long time_report(param_t *, int, struct rusage *);
+
+/* line_prof.c */
+void lprof_wait(timing_t *, struct timespec *);
+void lprof_add(param_t *, unsigned int, timing_t *, long);
+int lprof_run(param_t *, cmd_t *, unsigned int);
+
+/* lprof_report.c */
+void lprof_report(param_t *);
+
+/* parse.c */
+cmd_t *parse_line(char *);
+void free_cmds(cmd_t *);
+
+/* parse_cache.c */
+void pc_release(parse_ent_t *);
+parse_ent_t *pc_lookup(param_t *, char *);
+parse_ent_t *pc_insert(param_t *, char *, cmd_t *);
+
+/* pcache_builtin.c */
+int _pcache(param_t *);
+
+/* trace.c */
+int trace_open(param_t *);
+void trace_flush(void);
+void trace_child(void);
+void trace_close(void);
+
+/* trace_event.c */
+void trace_event(char *, int, char *);
+
+/* alloc_prof.c */
+void *prof_malloc(size_t, const char *, int);
+void *prof_realloc(void *, size_t, const char *, int);
+void prof_free(void *);
+
+/* alloc_tag.c */
+int prof_on(void);
+void prof_enter(const char *, int);
+void *prof_leave(void *);
+void prof_mark(unsigned long *);
+void prof_command(char *, unsigned long *);
+
+/* allocprof_builtin.c */
+int _allocprof(param_t *);
+void prof_leaks(void);
+
+/* stats_builtin.c */
+int _shellstats(param_t *);
+
+/* exec_cmds.c */
+void load_cmd(param_t *, cmd_t *);
+char *cmd_text(cmd_t *);
+int run_cmds(param_t *, cmd_t *);
+int run_text(param_t *, char *);
+
+/* bytecode.c */
+unsigned long bc_get_num(strbuf_t *, size_t *, int);
+int bc_put_num(strbuf_t *, unsigned long, int);
+int bc_put_line(strbuf_t *, unsigned int, cmd_t *);
+
+/* bc_decode.c */
+cmd_t *bc_get_line(strbuf_t *, size_t *, unsigned int *);
+
+/* bc_cache.c */
+unsigned long bc_checksum(strbuf_t *);
+char *bc_cache_path(param_t *, struct stat *);
+int bc_header(strbuf_t *, struct stat *);
+int bc_load(param_t *, struct stat *, strbuf_t *);
+int bc_save(param_t *, struct stat *, strbuf_t *);
+
+/* script.c */
+int compile_script(param_t *, strbuf_t *);
+int run_script(param_t *, char **, int *);
+
+/* builtin_echo.c */
+int put_escape(char **, int);
+int _echo(param_t *);
+int _pwd(param_t *);
+int _true(param_t *);
+int _false(param_t *);
+
+/* builtin_printf.c */
+int _printf(param_t *);
+
+/* builtin_test.c */
+int test_expr(char **, int);
+int _test(param_t *);
+
+/* strbuf.c */
+int sb_grow(strbuf_t *, size_t);
+int sb_append(strbuf_t *, const char *, size_t);
+ssize_t sb_read_fd(strbuf_t *, int);
+void sb_free(strbuf_t *);
+
+/* par.c */
+char **par_cmds(param_t *, int);
+int _par(param_t *);
+
+/* par_run.c */
+int par_run(param_t *, char **, int);
+
+/* jobs.c */
+job_t *add_job(param_t *, pid_t *, int, char *);
+job_t *get_job(param_t *, char *);
+int update_job(job_t *, int);
+void reap_jobs(param_t *);
+void remove_job(param_t *, job_t *);
+
+/* jobs_builtins.c */
+void print_job(job_t *);
+int _jobs(param_t *);
+int _fg(param_t *);
+int _bg(param_t *);
+int _wait(param_t *);
+
+/* hash_builtin.c */
+size_t print_hash(cmd_hash_t *);
+int print_hash_stats(cmd_hash_t *);
+int _hash(param_t *);
+
 /* loop.c */
 int loop(char **);
 
@@ -136,6 +908,8 @@ int _strlen(char *);
 int _strcmp(char *, char *);
 char *starts_with(const char *, const char *);
 char *_strcat(char *, char *);
+unsigned long hash_str(const char *);
+unsigned long hash_line(const char *);
 
 /* toem_string1.c */
 char *_strcpy(char *, char *);
@@ -199,17 +973,71 @@ int _mysetenv(param_t *);
 int _myunsetenv(param_t *);
 int populate_env_list(param_t *);
 
+/* env_map.c */
+long *env_slot(env_map_t *, const char *);
+int env_rehash(env_map_t *, size_t);
+int env_put(env_map_t *, char *);
+int env_del(env_map_t *, const char *);
+
 /* toem_getenv.c */
 char **get_environ(param_t *);
+void env_free(env_map_t *);
 int _unsetenv(param_t *, char *);
 int _setenv(param_t *, char *, char *);
 
 /* toem_history.c */
-char *get_history_file(param_t *info);
+char *get_history_file(param_t *info, char *suffix);
 int write_history(param_t *info);
 int read_history(param_t *info);
-int build_history_list(param_t *info, char *buf, int linecount);
-int renumber_history(param_t *info);
+int hist_add(param_t *info, char *line, size_t len);
+
+/* hist_time.c */
+hist_time_t *hist_time_get(param_t *, int);
+int hist_time_set(param_t *, int, hist_time_t *);
+int hist_run(param_t *, char *);
+
+/* hist_ring.c */
+int hist_layout(hist_ring_t *, size_t, size_t);
+void hist_evict(hist_ring_t *);
+hist_ent_t *hist_entry(param_t *, int);
+size_t hist_size(param_t *);
+void hist_free(param_t *);
+
+/* hist_db.c */
+int hist_time_parse(param_t *, char *, size_t, int);
+size_t hist_time_fmt(param_t *, int, char *);
+hist_ring_t *hist_new(void);
+int hist_load(param_t *);
+
+/* hist_file.c */
+void hist_open(param_t *);
+int hist_lock(param_t *);
+void hist_append(param_t *, char *, size_t, int);
+
+/* hist_index.c */
+long hist_index_start(param_t *, char *, long, long *);
+void hist_read(param_t *, char *, long, long);
+int hist_pull(param_t *);
+
+/* hist_compact.c */
+int hist_compact(param_t *);
+
+/* hist_gram.c */
+hist_gram_t *hist_gram_get(hist_find_t *, unsigned int);
+int hist_gram_add(hist_find_t *, unsigned int, int);
+void hist_find_free(hist_find_t *);
+
+/* hist_trie.c */
+int hist_trie_add(hist_find_t *, unsigned char *, size_t, int);
+int hist_trie_find(hist_find_t *, unsigned char *, size_t);
+int hist_trie_collect(hist_find_t *, int, strbuf_t *);
+
+/* hist_search.c */
+hist_find_t *hist_find_sync(param_t *);
+int hist_search(param_t *, char **);
+
+/* hist_stats.c */
+int hist_stats(param_t *);
 
 /* toem_lists.c */
 list_t *add_node(list_t **, const char *, int);
@@ -226,10 +1054,28 @@ list_t *node_starts_with(list_t *, char *, char);
 ssize_t get_node_index(list_t *, list_t *);
 
 /* toem_vars.c */
-int is_chain(param_t *, char *, size_t *);
-void check_chain(param_t *, char *, size_t *, size_t, size_t);
 int replace_alias(param_t *);
+char *var_value(param_t *, char *);
 int replace_vars(param_t *);
 int replace_string(char **, char *);
 
+/*
+ * Every allocation goes through the profiler, which tags it with the
+ * place it was made. The helpers that allocate for their caller are
+ * tagged where they are called, see alloc_tag.c.
+ */
+#if ALLOC_PROF && !defined(ALLOC_PROF_IMPL)
+#define malloc(n)	prof_malloc((n), __FILE__, __LINE__)
+#define realloc(p, n)	prof_realloc((p), (n), __FILE__, __LINE__)
+#define free(p)		prof_free(p)
+#define PROF_TAG(type, call) \
+	((type)prof_leave((prof_enter(__FILE__, __LINE__), (call))))
+#define _strdup(s)	PROF_TAG(char *, _strdup(s))
+#define _realloc(p, o, n)	PROF_TAG(void *, _realloc(p, o, n))
+#define _strtok(s, d)	PROF_TAG(char **, _strtok(s, d))
+#define list_to_strings(h)	PROF_TAG(char **, list_to_strings(h))
+#define add_node(h, s, n)	PROF_TAG(list_t *, add_node(h, s, n))
+#define add_node_end(h, s, n)	PROF_TAG(list_t *, add_node_end(h, s, n))
+#endif
+
 #endif
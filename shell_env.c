@@ -8,7 +8,14 @@
  */
 int _env(param_t *info)
 {
-	print_list_str(info->env);
+	size_t i;
+
+	for (i = 0; info->env && i < info->env->len; i++)
+		if (info->env->var[i])
+		{
+			_puts(info->env->var[i]);
+			_puts("\n");
+		}
 	return (0);
 }
 
@@ -16,23 +23,23 @@ int _env(param_t *info)
  * _getenv - Gets the value of an environment variable.
  * @info: Structure containing potential arguments. Used to maintain
  *          a constant function prototype.
- * @name: Name of the environment variable.
+ * @name: Name of the environment variable, with or without its '='.
+ *
+ * The variable is found through the hash table of the environment, see
+ * env_map.c.
  *
- * Return: The value of the environment variable or NULL if not found.
+ * Return: The value of the environment variable or NULL if not found
+ *	or empty.
  */
 char *_getenv(param_t *info, const char *name)
 {
-	list_t *node = info->env;
+	long *s = env_slot(info->env, name);
 	char *p;
 
-	while (node)
-	{
-		p = starts_with(node->str, name);
-		if (p && *p)
-			return (p);
-		node = node->next;
-	}
-	return (NULL);
+	if (!s || *s <= 0)
+		return (NULL);
+	p = _strchr(info->env->var[*s - 1], '=');
+	return (p && p[1] ? p + 1 : NULL);
 }
 
 /**
@@ -76,18 +83,29 @@ int _myunsetenv(param_t *info)
 }
 
 /**
- * populate_env_list - Populates the env linked list.
+ * populate_env_list - Copies environ into the environment of the shell.
  * @info: Structure containing potential arguments. Used to maintain
  *          a constant function prototype.
- * Return: Always 0.
+ *
+ * The table is sized for all of environ up front, so it is built once.
+ *
+ * Return: 0 on success, 1 on allocation failure.
  */
 int populate_env_list(param_t *info)
 {
-	list_t *node = NULL;
+	env_map_t *m = malloc(sizeof(env_map_t));
 	size_t i;
 
+	if (!m)
+		return (1);
+	_memset((void *)m, 0, sizeof(env_map_t));
+	info->env = m;
+	for (i = 0; environ[i]; i++)
+		;
+	if (env_rehash(m, i))
+		return (1);
 	for (i = 0; environ[i]; i++)
-		add_node_end(&node, environ[i], 0);
-	info->env = node;
+		if (env_put(m, _strdup(environ[i])))
+			return (1);
 	return (0);
 }
@@ -14,26 +14,30 @@ int shell(param_t *info, char **av)
 	ssize_t r = 0;
 	int builtin_ret = 0;
 
+	info->fname = av[0];
+	if (COMPILE_SCRIPTS && info->readfd > 2)
+		r = run_script(info, av, &builtin_ret);
 	while (r != -1 && builtin_ret != -2)
 	{
 		clear_param(info);
+		if (info->jobs)
+			reap_jobs(info);
 		if (is_interactive(info))
 			_puts("$ ");
 		_eputchar(BUFFER_FLUSH);
+		trace_event("read", 'B', NULL);
 		r = get_input(info);
+		trace_event("read", 'E', NULL);
 		if (r != -1)
-		{
-			set_param(info, av);
-			builtin_ret = find_builtin(info);
-			if (builtin_ret == -1)
-				find_cmd(info);
-		}
+			builtin_ret = hist_run(info, info->arg);
 		else if (is_interactive(info))
 			_putchar('\n');
 		free_param(info, 0);
 	}
+	lprof_report(info);
 	write_history(info);
 	free_param(info, 1);
+	prof_leaks();
 	if (!is_interactive(info) && info->status)
 		exit(info->status);
 	if (builtin_ret == -2)
@@ -58,7 +62,32 @@ int shell(param_t *info, char **av)
  */
 int find_builtin(param_t *info)
 {
-	int i, built_in_ret = -1;
+	int (*func)(param_t *) = get_builtin(info->argv[0]);
+	int ret;
+
+	if (!func)
+		return (-1);
+	shell_stats[ST_BUILTINS]++;
+	if (info->linecount_flag == 1)
+	{
+		info->line_count++;
+		info->linecount_flag = 0;
+	}
+	trace_event("builtin", 'B', info->argv[0]);
+	ret = func(info);
+	trace_event("builtin", 'E', NULL);
+	return (ret);
+}
+
+/**
+ * get_builtin - Looks up the function implementing a builtin.
+ * @name: The command name.
+ *
+ * Return: The builtin's function, or NULL if name is not a builtin.
+ */
+int (*get_builtin(char *name))(param_t *)
+{
+	int i;
 	builtin_t builtintbl[] = {
 		{"exit", _myexit},
 		{"env", _env},
@@ -68,17 +97,29 @@ int find_builtin(param_t *info)
 		{"unsetenv", _myunsetenv},
 		{"cd", change_dir},
 		{"alias", _alias},
+		{"hash", _hash},
+		{"pcache", _pcache},
+		{"shellstats", _shellstats},
+		{"allocprof", _allocprof},
+		{"jobs", _jobs},
+		{"fg", _fg},
+		{"bg", _bg},
+		{"wait", _wait},
+		{"par", _par},
+		{"echo", _echo},
+		{"printf", _printf},
+		{"test", _test},
+		{"[", _test},
+		{"pwd", _pwd},
+		{"true", _true},
+		{"false", _false},
 		{NULL, NULL}
 	};
 
-	for (i = 0; builtintbl[i].type; i++)
-		if (_strcmp(info->argv[0], builtintbl[i].type) == 0)
-		{
-			info->line_count++;
-			built_in_ret = builtintbl[i].func(info);
-			break;
-		}
-	return (built_in_ret);
+	for (i = 0; name && builtintbl[i].type; i++)
+		if (_strcmp(name, builtintbl[i].type) == 0)
+			return (builtintbl[i].func);
+	return (NULL);
 }
 
 /**
@@ -106,7 +147,9 @@ void find_cmd(param_t *info)
 	if (!k)
 		return;
 
-	path = find_path(info, _getenv(info, "PATH="), info->argv[0]);
+	trace_event("path", 'B', info->argv[0]);
+	path = hash_find(info, info->argv[0]);
+	trace_event("path", 'E', NULL);
 	if (path)
 	{
 		info->path = path;
@@ -126,10 +169,10 @@ void find_cmd(param_t *info)
 }
 
 /**
- * fork_cmd - Fork a child process to execute a command.
+ * fork_cmd - Start a child process to execute a command.
  * @info: Pointer to the parameter & return info struct.
  *
- * This function forks a child process to execute the command.
+ * This function starts the command with launch_cmd() and waits for it.
  *
  * Return: void.
  */
@@ -137,32 +180,16 @@ void fork_cmd(param_t *info)
 {
 	pid_t child_pid;
 
-	child_pid = fork();
+	_putchar(BUFFER_FLUSH);
+	_eputchar(BUFFER_FLUSH);
+	trace_event("spawn", 'B', info->argv[0]);
+	child_pid = launch_cmd(info, NULL);
+	trace_event("spawn", 'E', NULL);
 	if (child_pid == -1)
 	{
-		/* TODO: PUT ERROR FUNCTION */
-		perror("Error:");
+		launch_error(info, errno);
 		return;
 	}
-	if (child_pid == 0)
-	{
-		if (execve(info->path, info->argv, get_environ(info)) == -1)
-		{
-			free_param(info, 1);
-			if (errno == EACCES)
-				exit(126);
-			exit(1);
-		}
-		/* TODO: PUT ERROR FUNCTION */
-	}
-	else
-	{
-		wait(&(info->status));
-		if (WIFEXITED(info->status))
-		{
-			info->status = WEXITSTATUS(info->status);
-			if (info->status == 126)
-				_perror(info, "Permission denied\n");
-		}
-	}
+	if (!wait_child(info, child_pid) && info->status == 126)
+		_perror(info, "Permission denied\n");
 }
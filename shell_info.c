@@ -10,6 +10,7 @@ void clear_param(param_t *info)
 	info->argv = NULL;
 	info->path = NULL;
 	info->argc = 0;
+	info->bg = 0;
 }
 
 /**
@@ -53,17 +54,26 @@ void free_param(param_t *info, int all)
 	ffree(info->argv);
 	info->argv = NULL;
 	info->path = NULL;
+	redir_close(info);
+	info->redir = NULL;
 	if (all)
 	{
 		if (!info->cmd_buf)
 			free(info->arg);
-		if (info->env)
-			free_list(&(info->env));
-		if (info->history)
-			free_list(&(info->history));
+		env_free(info->env);
+		info->env = NULL;
+		hist_free(info);
 		if (info->alias)
 			free_list(&(info->alias));
-		ffree(info->environ);
+		hash_clear(info);
+		bfree((void **)&(info->cmdhash));
+		pc_insert(info, NULL, NULL);
+		bfree((void **)&(info->pcache));
+		sb_free(&(info->lineprof));
+		trace_close();
+		while (info->jobs)
+			remove_job(info, info->jobs);
+		free(info->environ);
 		info->environ = NULL;
 		bfree((void **)info->cmd_buf);
 		if (info->readfd > 2)
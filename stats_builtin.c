@@ -0,0 +1,44 @@
+#include "shell.h"
+
+unsigned long shell_stats[ST_COUNT];
+
+/**
+ * _shellstats - Prints or resets the shell's hot path counters.
+ * @info: Structure containing potential arguments. Used to maintain
+ *        a constant function prototype.
+ *
+ * `shellstats' prints one name=value line per counter, in the order of
+ * the ST_ constants; `shellstats -r' zeroes them. The counters are
+ * plain increments kept on all the time. Those of forked children,
+ * such as pipeline builtins, stay in the child.
+ *
+ * Return: 0 on success, 2 on a bad option.
+ */
+int _shellstats(param_t *info)
+{
+	char *names[] = {"parse_lines", "parse_cmds", "builtins", "execs",
+		"forks", "spawns", "stat_calls", "read_calls", "read_bytes",
+		"write_calls", "write_bytes", "environ_builds", "strdup_allocs",
+		"realloc_allocs", "list_allocs"};
+	int i;
+
+	if (info->argc > 1 && _strcmp(info->argv[1], "-r"))
+	{
+		_eputs(info->fname);
+		_eputs(": shellstats: usage: shellstats [-r]\n");
+		return (2);
+	}
+	for (i = 0; i < ST_COUNT; i++)
+	{
+		if (info->argc > 1)
+		{
+			shell_stats[i] = 0;
+			continue;
+		}
+		_puts(names[i]);
+		_putchar('=');
+		_puts(convert_num_to_str(shell_stats[i], 10, CONVERT_UNSIGNED));
+		_putchar('\n');
+	}
+	return (0);
+}
@@ -1,5 +1,8 @@
 #include "shell.h"
 
+/* the functions, not the tagging macros of shell.h */
+#undef _strtok
+
 /**
  * **_strtok - Splits a string into words based on
  *		the provided delimiter string.
@@ -73,3 +73,40 @@ char *_strchr(char *s, char c)
 
 	return (NULL);
 }
+
+/**
+ * hash_str - computes the djb2 hash of a string
+ * @s: the string to hash
+ *
+ *	Description: This function is used to pick a bucket for string keyed
+ *	tables. It stops at the terminating null byte or at '=' so that a
+ *	"name=value" string hashes the same as its bare name.
+ *
+ * Return: the hash value
+ */
+unsigned long hash_str(const char *s)
+{
+	unsigned long h = 5381;
+
+	while (*s && *s != '=')
+		h = ((h << 5) + h) + (unsigned char)*s++;
+	return (h);
+}
+
+/**
+ * hash_line - computes the djb2 hash of a whole string
+ * @s: the string to hash
+ *
+ *	Description: Unlike hash_str() this does not stop at '=', so that
+ *	the lines `a=1' and `a=2' hash apart.
+ *
+ * Return: the hash value
+ */
+unsigned long hash_line(const char *s)
+{
+	unsigned long h = 5381;
+
+	while (*s)
+		h = ((h << 5) + h) + (unsigned char)*s++;
+	return (h);
+}
@@ -0,0 +1,87 @@
+#include "shell.h"
+
+/**
+ * sb_grow - Makes room for more bytes in a buffer.
+ * @sb: The buffer.
+ * @need: Number of bytes that must fit after the used ones.
+ *
+ * The capacity at least doubles on every reallocation, so filling a
+ * buffer byte by byte stays linear in its final size.
+ *
+ * Return: 0 on success, -1 on allocation failure.
+ */
+int sb_grow(strbuf_t *sb, size_t need)
+{
+	size_t cap = sb->cap ? sb->cap : 64;
+	char *s;
+
+	if (sb->len + need + 1 <= sb->cap)
+		return (0);
+	while (cap < sb->len + need + 1)
+		cap *= 2;
+	s = realloc(sb->s, cap);
+	if (!s)
+		return (-1);
+	sb->s = s;
+	sb->cap = cap;
+	return (0);
+}
+
+/**
+ * sb_append - Appends bytes to a buffer.
+ * @sb: The buffer.
+ * @data: The bytes to append.
+ * @n: Number of bytes to append.
+ *
+ * Return: 0 on success, -1 on allocation failure.
+ */
+int sb_append(strbuf_t *sb, const char *data, size_t n)
+{
+	size_t i;
+
+	if (sb_grow(sb, n))
+		return (-1);
+	for (i = 0; i < n; i++)
+		sb->s[sb->len++] = data[i];
+	sb->s[sb->len] = 0;
+	return (0);
+}
+
+/**
+ * sb_read_fd - Appends whatever one read() on a fd returns.
+ * @sb: The buffer.
+ * @fd: The file descriptor to read from.
+ *
+ * Reads are at least SB_READ_SIZE bytes, or the free space left in the
+ * buffer when that is larger.
+ *
+ * Return: The number of bytes read, 0 on end of file, -1 on error.
+ */
+ssize_t sb_read_fd(strbuf_t *sb, int fd)
+{
+	ssize_t r;
+
+	if (sb_grow(sb, SB_READ_SIZE))
+		return (-1);
+	do {
+		r = read(fd, sb->s + sb->len, sb->cap - sb->len - 1);
+		shell_stats[ST_READS]++;
+	} while (r == -1 && errno == EINTR);
+	if (r > 0)
+		sb->len += r, shell_stats[ST_READ_BYTES] += r;
+	sb->s[sb->len] = 0;
+	return (r);
+}
+
+/**
+ * sb_free - Frees the bytes of a buffer and empties it.
+ * @sb: The buffer.
+ *
+ * Return: void.
+ */
+void sb_free(strbuf_t *sb)
+{
+	free(sb->s);
+	sb->s = NULL;
+	sb->len = sb->cap = 0;
+}
@@ -1,5 +1,8 @@
 #include "shell.h"
 
+/* the functions, not the tagging macros of shell.h */
+#undef _strdup
+
 /**
  * _strcpy - Copies a source string to a destination string.
  * @dest: The destination string.
@@ -42,6 +45,7 @@ char *_strdup(const char *str)
 	ret = malloc(sizeof(char) * (length + 1));
 	if (!ret)
 		return (NULL);
+	shell_stats[ST_STRDUPS]++;
 	for (length++; length--;)
 		ret[length] = *--str;
 	return (ret);
@@ -80,9 +84,11 @@ int _putchar(char c)
 	static int i;
 	static char buf[BUF_WRITE_SIZE];
 
-	if (c == BUFFER_FLUSH || i >= BUF_WRITE_SIZE)
+	if ((c == BUFFER_FLUSH || i >= BUF_WRITE_SIZE) && i)
 	{
 		write(1, buf, i);
+		shell_stats[ST_WRITES]++;
+		shell_stats[ST_WRITE_BYTES] += i;
 		i = 0;
 	}
 	if (c != BUFFER_FLUSH)
@@ -0,0 +1,129 @@
+#include "shell.h"
+
+/**
+ * is_subst - Checks if a command substitution starts at a position.
+ * @s: The position in a word.
+ *
+ * Return: 1 for $( or a backquote, 0 otherwise.
+ */
+int is_subst(char *s)
+{
+	return ((s[0] == '$' && s[1] == '(') || s[0] == '`');
+}
+
+/**
+ * has_subst - Checks if a word holds a command substitution.
+ * @w: The word.
+ *
+ * Return: 1 if it does, 0 otherwise.
+ */
+int has_subst(char *w)
+{
+	for (; *w; w++)
+		if (is_subst(w))
+			return (1);
+	return (0);
+}
+
+/**
+ * subst_len - Measures the command substitution at a position.
+ * @s: The position, where is_subst() is true.
+ * @inner: Where to store the length of the command inside, or NULL.
+ *
+ * $( ) nests by counting parentheses, a backquoted command ends at the
+ * next backquote. An unterminated one runs to the end of the word's
+ * line.
+ *
+ * Return: The length of the substitution, delimiters included.
+ */
+size_t subst_len(char *s, size_t *inner)
+{
+	size_t k, open = *s == '`' ? 1 : 2;
+	int depth = 1;
+
+	for (k = open; s[k] && depth; k++)
+		if (*s == '`')
+			depth = s[k] != '`';
+		else if (s[k] == '(' || s[k] == ')')
+			depth += s[k] == '(' ? 1 : -1;
+	if (inner)
+		*inner = k - open - !depth;
+	return (k);
+}
+
+/**
+ * subst_child - Runs the command of a substitution in a forked shell.
+ * @info: Pointer to the parameter & return info struct.
+ * @cmd: The command line.
+ * @fds: The pipe, its write end becomes stdout.
+ *
+ * The child forgets the redirections of the command being expanded,
+ * which may be half opened, before running its own.
+ *
+ * Return: Does not return.
+ */
+static void subst_child(param_t *info, char *cmd, int *fds)
+{
+	sigset_t set;
+	int ret;
+
+	sigemptyset(&set);
+	sigprocmask(SIG_SETMASK, &set, NULL);
+	signal(SIGINT, SIG_DFL);
+	trace_child();
+	dup2(fds[1], STDOUT_FILENO);
+	info->redir = NULL;
+	info->redirfd = NULL;
+	ret = run_text(info, cmd);
+	_putchar(BUFFER_FLUSH);
+	_eputchar(BUFFER_FLUSH);
+	_exit(ret == -2 ? (info->err_num == -1 ? info->status : info->err_num)
+			: info->status);
+}
+
+/**
+ * subst_run - Runs a command and captures its standard output.
+ * @info: Pointer to the parameter & return info struct.
+ * @cmd: The command line.
+ * @out: The buffer the output is appended to.
+ *
+ * The output is read from a pipe with sb_read_fd(), whose reads grow
+ * with the buffer, so capturing megabytes takes a handful of reads
+ * and reallocations. The time spent reading counts as waiting for the
+ * child. Trailing newlines are removed, and the status is set to the
+ * command's.
+ *
+ * Return: 0 on success, -1 if the command could not be started.
+ */
+int subst_run(param_t *info, char *cmd, strbuf_t *out)
+{
+	struct timespec since;
+	int fds[2];
+	pid_t pid;
+
+	if (pipe2(fds, O_CLOEXEC) == -1)
+		return (perror("Error:"), -1);
+	trace_event("subst", 'B', cmd);
+	_putchar(BUFFER_FLUSH);
+	_eputchar(BUFFER_FLUSH);
+	shell_stats[ST_FORKS]++;
+	pid = fork();
+	if (pid == 0)
+		subst_child(info, cmd, fds);
+	close(fds[1]);
+	if (pid == -1)
+		return (close(fds[0]), perror("Error:"),
+				trace_event("subst", 'E', NULL), -1);
+	if (info->timing)
+		clock_gettime(CLOCK_MONOTONIC, &since);
+	while (sb_read_fd(out, fds[0]) > 0)
+		;
+	if (info->timing)
+		lprof_wait(info->timing, &since);
+	close(fds[0]);
+	wait_child(info, pid);
+	trace_event("subst", 'E', NULL);
+	while (out->len && out->s[out->len - 1] == '\n')
+		out->s[--out->len] = '\0';
+	return (0);
+}
@@ -0,0 +1,39 @@
+#!/bin/sh
+#
+# Checks the exit status of the test builtin on the forms POSIX decides
+# by argument count.
+#
+#	sh tests/test_builtin.sh ./hsh
+#
+# Each case is one line run through the shell: the expected status, then
+# the expression between [ and ].
+
+hsh=${1:-./hsh}
+fail=0
+
+while read -r want expr
+do
+	got=$(printf '[ %s ]\necho $?\n' "$expr" | "$hsh" 2>/dev/null)
+	if [ "$got" != "$want" ]
+	then
+		echo "FAIL: [ $expr ]: got $got, want $want"
+		fail=1
+	fi
+done <<'CASES'
+0 x -a y
+0 x -a -n
+1 ( -z x )
+0 -n -o y
+1 ! = x
+0 ! = !
+1 ! x
+0 ! x = y
+0 ( x )
+0 ( ! )
+0 ( -n x )
+0 ! -a x
+1 -n x -a -z y
+CASES
+
+[ "$fail" = 0 ] && echo "test builtin: all passed"
+exit "$fail"
@@ -0,0 +1,32 @@
+#!/bin/sh
+#
+# Checks the output of here-strings and here-documents.
+#
+#	sh tests/test_redir.sh ./hsh
+#
+# Each case is a line: the expected output, a '|', then the command line
+# run through the shell; "\n" in a command stands for a newline.
+
+hsh=${1:-./hsh}
+fail=0
+
+while IFS='|' read -r want cmd
+do
+	got=$(printf "$cmd\n" | HOME=/h "$hsh" 2>/dev/null)
+	if [ "$got" != "$want" ]
+	then
+		echo "FAIL: $cmd: got '$got', want '$want'"
+		fail=1
+	fi
+done <<'CASES'
+hi|cat <<< $(echo hi)
+ahib|cat <<< a$(echo hi)b
+x|cat <<< x
+hi /h|cat <<EOF\n$(echo hi) $HOME\nEOF
+$HOME|cat <<'EOF'\n$HOME\nEOF
+$HOME|cat <<\\EOF\n$HOME\nEOF
+x /h|cat <<-EOF\n\tx $HOME\n\tEOF
+CASES
+
+[ "$fail" = 0 ] && echo "redirections: all passed"
+exit "$fail"
@@ -0,0 +1,27 @@
+#!/bin/sh
+#
+# Checks the keys of the report of the time keyword.
+#
+#	sh tests/test_time.sh ./hsh
+#
+# Each case is a line: the expected first words of the report lines,
+# joined by spaces, a '|', then the timed command line.
+
+hsh=${1:-./hsh}
+fail=0
+
+while IFS='|' read -r want cmd
+do
+	got=$(echo "$cmd" | "$hsh" 2>&1 >/dev/null | cut -d' ' -f1 | xargs)
+	if [ "$got" != "$want" ]
+	then
+		echo "FAIL: $cmd: got '$got', want '$want'"
+		fail=1
+	fi
+done <<'CASES'
+real user sys|time -p true
+real user sys maxrss minflt majflt nvcsw nivcsw|time -v true
+CASES
+
+[ "$fail" = 0 ] && echo "time: all passed"
+exit "$fail"
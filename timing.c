@@ -0,0 +1,164 @@
+#include "shell.h"
+
+/**
+ * time_start - Starts timing a pipeline.
+ * @info: Pointer to the parameter & return info struct.
+ * @t: The timing to fill, made the innermost one until time_report().
+ *
+ * Return: void.
+ */
+void time_start(param_t *info, timing_t *t)
+{
+	_memset((void *)t, 0, sizeof(timing_t));
+	clock_gettime(CLOCK_MONOTONIC, &t->start);
+	getrusage(RUSAGE_SELF, &t->self);
+	t->prev = info->timing;
+	info->timing = t;
+}
+
+/**
+ * time_add - Adds the resource usage of a child to a timing.
+ * @t: The timing.
+ * @ru: The usage wait4() returned for the child.
+ *
+ * Times and counters are summed, the peak RSS is the largest one.
+ *
+ * Return: void.
+ */
+void time_add(timing_t *t, struct rusage *ru)
+{
+	struct rusage *k = &t->kids;
+
+	timeradd(&k->ru_utime, &ru->ru_utime, &k->ru_utime);
+	timeradd(&k->ru_stime, &ru->ru_stime, &k->ru_stime);
+	if (ru->ru_maxrss > k->ru_maxrss)
+		k->ru_maxrss = ru->ru_maxrss;
+	k->ru_minflt += ru->ru_minflt;
+	k->ru_majflt += ru->ru_majflt;
+	k->ru_nvcsw += ru->ru_nvcsw;
+	k->ru_nivcsw += ru->ru_nivcsw;
+	t->nkids++;
+}
+
+/**
+ * put_secs - Prints a duration to stderr.
+ * @name: Its label.
+ * @usec: The duration in microseconds.
+ * @fmt: TIME_HUMAN for "name\t1m2.345s", TIME_POSIX or TIME_KEYS for
+ *	"name 62.34".
+ *
+ * Return: void.
+ */
+static void put_secs(char *name, long usec, int fmt)
+{
+	long ms = usec / 1000;
+
+	_eputs(name);
+	_eputchar(fmt == TIME_HUMAN ? '\t' : ' ');
+	if (fmt == TIME_HUMAN)
+	{
+		_eputs(convert_num_to_str(ms / 60000, 10, 0));
+		_eputchar('m');
+	}
+	_eputs(convert_num_to_str(fmt == TIME_HUMAN ? ms / 1000 % 60
+				: ms / 1000, 10, 0));
+	_eputchar('.');
+	_eputchar('0' + ms / 100 % 10);
+	_eputchar('0' + ms / 10 % 10);
+	if (fmt == TIME_HUMAN)
+	{
+		_eputchar('0' + ms % 10);
+		_eputchar('s');
+	}
+	_eputchar('\n');
+}
+
+/**
+ * time_print - Prints the report of a timed pipeline to stderr.
+ * @ru: What the pipeline used, the shell's share included.
+ * @real: The wall clock time it took, in microseconds.
+ * @fmt: TIME_HUMAN, TIME_POSIX for the real, user and sys lines alone,
+ *	as POSIX requires, or TIME_KEYS for those followed by the RSS,
+ *	faults and context switches as "key value" lines.
+ *
+ * Return: void.
+ */
+static void time_print(struct rusage *ru, long real, int fmt)
+{
+	char *human[] = {"maxrss\t", " KiB\nfaults\t", " minor, ",
+		" major\nctxsw\t", " voluntary, ", " involuntary\n"};
+	char *posix[] = {"maxrss ", "\nminflt ", "\nmajflt ", "\nnvcsw ",
+		"\nnivcsw ", "\n"};
+	char **s = fmt == TIME_KEYS ? posix : human;
+	long n[5];
+	int i;
+
+	n[0] = ru->ru_maxrss, n[1] = ru->ru_minflt, n[2] = ru->ru_majflt;
+	n[3] = ru->ru_nvcsw, n[4] = ru->ru_nivcsw;
+	put_secs("real", real, fmt);
+	put_secs("user", ru->ru_utime.tv_sec * 1000000L
+			+ ru->ru_utime.tv_usec, fmt);
+	put_secs("sys", ru->ru_stime.tv_sec * 1000000L
+			+ ru->ru_stime.tv_usec, fmt);
+	for (i = 0; i < 5 && fmt != TIME_POSIX; i++)
+	{
+		_eputs(s[i]);
+		_eputs(convert_num_to_str(n[i], 10, 0));
+	}
+	if (fmt != TIME_POSIX)
+		_eputs(s[5]);
+	_eputchar(BUFFER_FLUSH);
+}
+
+/**
+ * time_report - Ends the innermost timing and prints its report.
+ * @info: Pointer to the parameter & return info struct.
+ * @fmt: TIME_HUMAN, TIME_POSIX or TIME_KEYS, 0 to print nothing.
+ * @ru: Where to store what was used, or NULL.
+ *
+ * The CPU time, faults and context switches are those of the children
+ * waited for plus what the shell itself used meanwhile, for builtins.
+ * The peak RSS is the largest child's, or the shell's when no child
+ * ran. The children and the time spent waiting for them are also
+ * counted in the enclosing timing.
+ *
+ * Return: The wall clock time taken, in microseconds.
+ */
+long time_report(param_t *info, int fmt, struct rusage *ru)
+{
+	timing_t *t = info->timing;
+	struct rusage now, *k;
+	struct timespec end;
+	long real;
+
+	if (!t)
+		return (0);
+	info->timing = t->prev;
+	if (t->prev && t->nkids)
+		time_add(t->prev, &t->kids);
+	if (t->prev)
+		t->prev->waited += t->waited;
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	getrusage(RUSAGE_SELF, &now);
+	k = &t->kids;
+	real = (end.tv_sec - t->start.tv_sec) * 1000000L
+		+ (end.tv_nsec - t->start.tv_nsec) / 1000;
+	timersub(&now.ru_utime, &t->self.ru_utime, &now.ru_utime);
+	timeradd(&now.ru_utime, &k->ru_utime, &now.ru_utime);
+	timersub(&now.ru_stime, &t->self.ru_stime, &now.ru_stime);
+	timeradd(&now.ru_stime, &k->ru_stime, &now.ru_stime);
+	now.ru_minflt += k->ru_minflt - t->self.ru_minflt;
+	now.ru_majflt += k->ru_majflt - t->self.ru_majflt;
+	now.ru_nvcsw += k->ru_nvcsw - t->self.ru_nvcsw;
+	now.ru_nivcsw += k->ru_nivcsw - t->self.ru_nivcsw;
+	if (t->nkids)
+		now.ru_maxrss = k->ru_maxrss;
+	if (ru)
+		*ru = now;
+	if (fmt)
+	{
+		_putchar(BUFFER_FLUSH);
+		time_print(&now, real, fmt);
+	}
+	return (real);
+}
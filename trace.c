@@ -0,0 +1,88 @@
+#include "shell.h"
+
+trace_t shell_trace = {-1, {NULL, 0, 0}, {0, 0}, "", 0};
+
+/**
+ * trace_open - Starts tracing if SHELL_TRACE names a file.
+ * @info: Pointer to the parameter & return info struct, env is set.
+ *
+ * The file is truncated and gets the opening bracket of a Chrome trace
+ * JSON array; it is close-on-exec and kept above fd 9.
+ *
+ * Return: 0 if tracing is on, -1 otherwise.
+ */
+int trace_open(param_t *info)
+{
+	char *file = _getenv(info, "SHELL_TRACE=");
+	int fd, high;
+
+	if (!file || !*file)
+		return (-1);
+	fd = open(file, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (fd >= 0 && fd < 10)
+	{
+		high = fcntl(fd, F_DUPFD_CLOEXEC, 10);
+		close(fd);
+		fd = high;
+	}
+	if (fd == -1)
+		return (redir_error(info, "cannot create ", file));
+	shell_trace.fd = fd;
+	clock_gettime(CLOCK_MONOTONIC, &shell_trace.start);
+	_strcpy(shell_trace.tail, ",\"pid\":");
+	_strcat(shell_trace.tail, convert_num_to_str(getpid(), 10, 0));
+	_strcat(shell_trace.tail, ",\"tid\":1");
+	shell_trace.count = 0;
+	return (sb_append(&shell_trace.buf, "[\n", 2));
+}
+
+/**
+ * trace_flush - Writes out the buffered trace events.
+ *
+ * Return: void.
+ */
+void trace_flush(void)
+{
+	strbuf_t *b = &shell_trace.buf;
+	size_t done;
+	ssize_t w;
+
+	for (done = 0; shell_trace.fd >= 0 && done < b->len; done += w)
+	{
+		w = write(shell_trace.fd, b->s + done, b->len - done);
+		if (w <= 0 && errno != EINTR)
+			break;
+		w = w < 0 ? 0 : w;
+	}
+	b->len = 0;
+}
+
+/**
+ * trace_child - Turns tracing off in a forked copy of the shell.
+ *
+ * The child drops the events it inherited, which the shell writes
+ * itself, and records none of its own.
+ *
+ * Return: void.
+ */
+void trace_child(void)
+{
+	shell_trace.fd = -1;
+	sb_free(&shell_trace.buf);
+}
+
+/**
+ * trace_close - Ends the trace and closes its file.
+ *
+ * Return: void.
+ */
+void trace_close(void)
+{
+	if (shell_trace.fd < 0)
+		return;
+	sb_append(&shell_trace.buf, "\n]\n", 3);
+	trace_flush();
+	close(shell_trace.fd);
+	shell_trace.fd = -1;
+	sb_free(&shell_trace.buf);
+}
@@ -0,0 +1,92 @@
+#include "shell.h"
+
+/**
+ * trace_cpy - Copies a string into the trace buffer.
+ * @d: Where to copy it.
+ * @s: The string.
+ *
+ * Return: The end of the copy.
+ */
+static char *trace_cpy(char *d, const char *s)
+{
+	while (*s)
+		*d++ = *s++;
+	return (d);
+}
+
+/**
+ * trace_json - Copies a string into the trace buffer as JSON text.
+ * @d: Where to copy it, with room for 6 bytes per character.
+ * @s: The string; quotes, backslashes and control characters are
+ *	escaped.
+ *
+ * Return: The end of the copy.
+ */
+static char *trace_json(char *d, char *s)
+{
+	for (; *s; s++)
+	{
+		if (*s == '"' || *s == '\\')
+			*d++ = '\\';
+		else if ((unsigned char)*s < ' ')
+		{
+			d = trace_cpy(d, "\\u00");
+			*d++ = "0123456789abcdef"[*s >> 4];
+			*d++ = "0123456789abcdef"[*s & 15];
+			continue;
+		}
+		*d++ = *s;
+	}
+	return (d);
+}
+
+/**
+ * trace_event - Records the beginning or the end of a phase.
+ * @name: The phase: "read", "parse", "expand", "path", "spawn",
+ *	"wait", "builtin", "subst" or "compile".
+ * @ph: 'B' when the phase begins, 'E' when it ends.
+ * @arg: The command the phase is about, or NULL.
+ *
+ * An event is formatted straight into the buffer, which is written
+ * out every TRACE_FLUSH_SIZE bytes, so it costs a clock read and a
+ * hundred byte copies. Timestamps are microseconds of the monotonic
+ * clock since tracing started.
+ *
+ * Return: void.
+ */
+void trace_event(char *name, int ph, char *arg)
+{
+	strbuf_t *b = &shell_trace.buf;
+	struct timespec ts;
+	unsigned long us;
+	char num[24], *n = num + sizeof(num) - 1, *d;
+
+	if (shell_trace.fd < 0)
+		return;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	us = (ts.tv_sec - shell_trace.start.tv_sec) * 1000000L
+		+ (ts.tv_nsec - shell_trace.start.tv_nsec) / 1000;
+	*n = '\0';
+	do {
+		*--n = '0' + us % 10;
+		us /= 10;
+	} while (us);
+	if (sb_grow(b, 160 + (arg ? _strlen(arg) * 6 : 0)))
+		return;
+	d = trace_cpy(b->s + b->len, shell_trace.count++ ? ",\n{\"name\":\""
+			: "{\"name\":\"");
+	d = trace_cpy(trace_cpy(d, name), "\",\"ph\":\"");
+	*d++ = ph;
+	d = trace_cpy(trace_cpy(trace_cpy(d, "\",\"ts\":"), n),
+			shell_trace.tail);
+	if (arg)
+	{
+		d = trace_cpy(d, ",\"args\":{\"cmd\":\"");
+		d = trace_cpy(trace_json(d, arg), "\"}");
+	}
+	*d++ = '}';
+	*d = '\0';
+	b->len = d - b->s;
+	if (b->len >= TRACE_FLUSH_SIZE)
+		trace_flush();
+}